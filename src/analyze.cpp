@@ -744,8 +744,12 @@ void Internal::analyze () {
       bump_variables();
 
     if (external->learner) external->export_learned_large_clause (clause, glue);
-  } else if (external->learner)
-    external->export_learned_unit_clause(-uip);
+    if (external->batch_learner)
+      external->buffer_learned_large_clause (clause, glue);
+  } else {
+    if (external->learner) external->export_learned_unit_clause(-uip);
+    if (external->batch_learner) external->buffer_learned_unit_clause (-uip);
+  }
 
   // Update actual size statistics.
   //
@@ -1,30 +1,171 @@
 #include "internal.hpp"
 
+#ifdef WATCH32
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
 namespace CaDiCaL {
 
+#ifdef WATCH32
+
+// We try to reserve 16 GB of address space which is the maximum which can
+// be addressed by 31 bits of a clause reference in units of 8 bytes.  Only
+// the pages actually touched are committed.  If the address space is
+// limited (for instance with 'ulimit -v') we retry with half the size.
+
+static const size_t arena_reserved_bytes = (size_t) 1 << 34;
+static const size_t arena_minimum_bytes = (size_t) 1 << 24;
+
+Arena::Arena (Internal * i) {
+  memset (this, 0, sizeof *this);
+  internal = i;
+  size_t bytes = arena_reserved_bytes;
+  void * p;
+  for (;;) {
+    p = mmap (0, bytes, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p != MAP_FAILED) break;
+    if (bytes <= arena_minimum_bytes)
+      fatal ("failed to reserve %zd bytes of arena address space", bytes);
+    bytes /= 2;
+  }
+  base = (char *) p;
+  half = bytes / 2;
+  from.start = from.top = base;
+  from.end = base + half;
+}
+
+Arena::~Arena () {
+  munmap (base, 2*half);
+}
+
+// Options are only known after construction.  Thus transparent huge pages
+// are advised for the whole reserved address space on first allocation.
+
+void Arena::advise () {
+  if (advised) return;
+  advised = true;
+#ifdef MADV_HUGEPAGE
+  if (internal->opts.hugepages) madvise (base, 2*half, MADV_HUGEPAGE);
+#endif
+}
+
+char * Arena::allocate (size_t bytes) {
+  if (!advised) advise ();
+  char * res = from.top;
+  if ((size_t) (from.end - res) < bytes)
+    fatal ("out of arena memory (at most %zd bytes per space)", half);
+  from.top += bytes;
+  return res;
+}
+
+void Arena::prepare (size_t bytes) {
+  LOG ("preparing 'to' space of arena with %zd bytes", bytes);
+  assert (!to.start);
+  if (bytes > half)
+    fatal ("out of arena memory (at most %zd bytes per space)", half);
+  advise ();
+  to.top = to.start = (from.start == base) ? base + half : base;
+  to.end = to.start + half;
+}
+
+void Arena::swap () {
+  const size_t bytes = from.top - from.start;
+  if (bytes) madvise (from.start, bytes, MADV_DONTNEED);
+  LOG ("release 'from' space of arena with %zd bytes", bytes);
+  from = to;
+  to.start = to.top = to.end = 0;
+}
+
+#else
+
+// Initial and maximum size of the nursery for learned clauses.
+
+static const size_t nursery_initial_bytes = (size_t) 1 << 20;
+static const size_t nursery_maximum_bytes = (size_t) 1 << 28;
+
 Arena::Arena (Internal * i) {
   memset (this, 0, sizeof *this);
   internal = i;
 }
 
 Arena::~Arena () {
-  delete [] from.start;
-  delete [] to.start;
+  free (from.start);
+  free (to.start);
+  free (nursery.start);
+  free (young.start);
+  free (youngto.start);
+}
+
+// All spaces are allocated here, which uses transparent huge pages if
+// requested (see 'allocate_huge_pages' in 'resources.cpp').  Note that
+// even empty spaces need a unique non-zero start address.
+
+char * Arena::new_space (size_t bytes) {
+  if (!bytes) bytes = 1;
+  void * res;
+  if (internal->opts.hugepages) res = allocate_huge_pages (bytes);
+  else res = malloc (bytes);
+  if (!res) throw std::bad_alloc ();
+  return (char *) res;
+}
+
+char * Arena::overflow_nursery (size_t bytes) {
+  if (!nursery.start && bytes <= nursery_initial_bytes) {
+    LOG ("allocating nursery of arena with %zd bytes",
+      nursery_initial_bytes);
+    nursery.top = nursery.start = new_space (nursery_initial_bytes);
+    nursery.end = nursery.start + nursery_initial_bytes;
+    return allocate_nursery (bytes);
+  }
+  overflow = true;
+  return 0;
 }
 
 void Arena::prepare (size_t bytes) {
   LOG ("preparing 'to' space of arena with %zd bytes", bytes);
   assert (!to.start);
-  to.top = to.start = new char[bytes];
+  to.top = to.start = new_space (bytes);
   to.end = to.start + bytes;
 }
 
 void Arena::swap () {
-  delete [] from.start;
+  free (from.start);
   LOG ("delete 'from' space of arena with %zd bytes",
     (size_t) (from.end - from.start));
   from = to;
   to.start = to.top = to.end = 0;
 }
 
+void Arena::prepare_young (size_t bytes) {
+  LOG ("preparing 'youngto' space of arena with %zd bytes", bytes);
+  assert (!youngto.start);
+  youngto.top = youngto.start = new_space (bytes);
+  youngto.end = youngto.start + bytes;
+}
+
+void Arena::swap_young () {
+  free (young.start);
+  LOG ("delete 'young' space of arena with %zd bytes",
+    (size_t) (young.end - young.start));
+  young = youngto;
+  youngto.start = youngto.top = youngto.end = 0;
+
+  // All surviving nursery clauses have been moved by now.
+  //
+  const size_t size = nursery.end - nursery.start;
+  if (overflow && size && size < nursery_maximum_bytes) {
+    free (nursery.start);
+    LOG ("enlarging nursery of arena to %zd bytes", 2*size);
+    nursery.start = new_space (2*size);
+    nursery.end = nursery.start + 2*size;
+  }
+  nursery.top = nursery.start;
+  overflow = false;
+}
+
+#endif
+
 }
@@ -51,6 +51,33 @@ namespace CaDiCaL {
 //
 // One has to be really careful with 'qi' references to arena memory.
 
+// Redundant (learned) clauses can alternatively be allocated in a separate
+// 'nursery' (if 'opts.arenanursery' is set) by just bumping a pointer.
+// This avoids calling 'malloc' and 'free' during conflict analysis, which
+// otherwise leads to fragmentation and allocator contention if many solver
+// instances run in the same process.  The moving garbage collector then
+// evacuates surviving nursery clauses and the nursery is reset (and
+// enlarged if it overflowed before) in 'swap_young'.  If the nursery is
+// full new clauses are allocated outside of the arena as before.
+
+// With generational garbage collection ('opts.arenagen') the 'from' space
+// is the 'old' generation holding irredundant and tier-one clauses, while
+// tier-two and tier-three learned clauses survive in a separate 'young'
+// space.  The nursery and the young space form the young generation.  A
+// minor collection ('copy_young_clauses' in 'collect.cpp') only moves the
+// surviving clauses of the young generation to 'youngto' (prepared with
+// 'prepare_young') and does not touch the old generation at all.  Garbage
+// clauses in the old generation are only reclaimed by a major collection,
+// which moves both generations and is much less frequent.
+
+// If compiled with '-DWATCH32' watches use 32-bit clause references (see
+// 'watch.hpp'), which requires all clauses to be allocated in the arena,
+// including new clauses, which are then allocated with 'allocate' at the
+// end of the 'from' space.  In this mode we reserve (but do not commit)
+// address space for both the 'from' and 'to' space once and use the two
+// halves alternatingly, such that clause references (offsets relative to
+// the start of the reserved address space) remain valid in both spaces.
+
 struct Internal;
 
 class Arena {
@@ -59,6 +86,18 @@ class Arena {
 
   struct { char * start, * top, * end; } from, to;
 
+#ifdef WATCH32
+  char * base;          // start of reserved address space
+  size_t half;          // size of each of the two halves
+  bool advised;         // huge pages advised
+  void advise ();
+#else
+  struct { char * start, * top, * end; } nursery, young, youngto;
+  bool overflow;        // nursery overflowed since last 'swap_young'
+  char * overflow_nursery (size_t bytes);
+  char * new_space (size_t bytes);
+#endif
+
 public:
 
   Arena (Internal *);
@@ -69,6 +108,7 @@ public:
   // can use as much memory in sum as pre-allocated here.
   //
   void prepare (size_t bytes);
+  bool prepared () const { return to.start; }
 
   // Does the memory pointed to by 'p' belong to this arena? More precisely
   // to the 'from' space, since that is the only one remaining after 'swap'.
@@ -96,6 +136,88 @@ public:
   // explicitly copied to 'to' with 'copy' becomes invalid.
   //
   void swap ();
+
+  // Allocated memory of all spaces (actually touched with '-DWATCH32').
+  //
+  size_t bytes () const {
+#ifdef WATCH32
+    return (from.top - from.start) + (to.top - to.start);
+#else
+    return (from.end - from.start) + (to.end - to.start) +
+           (nursery.end - nursery.start) + (young.end - young.start) +
+           (youngto.end - youngto.start);
+#endif
+  }
+
+#ifndef WATCH32
+
+  // Allocate memory for a new clause in the nursery.  Returns zero if the
+  // nursery is full (or not allocated yet and 'bytes' exceeds its size).
+  //
+  char * allocate_nursery (size_t bytes) {
+    char * res = nursery.top;
+    if ((size_t) (nursery.end - res) < bytes)
+      return overflow_nursery (bytes);
+    nursery.top += bytes;
+    return res;
+  }
+
+  // Does the memory pointed to by 'p' belong to the young generation?
+  //
+  bool young_contains (void * p) const {
+    char * c = (char *) p;
+    if (nursery.start <= c && c < nursery.top) return true;
+    return young.start <= c && c < young.top;
+  }
+
+  bool young_occupied () const {
+    return nursery.top != nursery.start || young.top != young.start;
+  }
+
+  // Bytes allocated in the old generation by the last major collection.
+  //
+  size_t old_bytes () const { return from.top - from.start; }
+
+  // Same as 'prepare' and 'copy' but for the young generation.
+  //
+  void prepare_young (size_t bytes);
+  bool young_prepared () const { return youngto.start; }
+
+  char * copy_young (const char * p, size_t bytes) {
+    char * res = youngto.top;
+    youngto.top += bytes;
+    assert (youngto.top <= youngto.end);
+    memcpy (res, p, bytes);
+    return res;
+  }
+
+  // Delete 'young' space, replace it by 'youngto' and reset the nursery.
+  // This has to be called after both minor and major collections.
+  //
+  void swap_young ();
+
+#else
+
+  // Allocate new memory at the end of the 'from' space.
+  //
+  char * allocate (size_t bytes);
+
+  // Map arena memory to 32-bit references and back.  These are the offsets
+  // relative to 'base' in units of 8 bytes.
+  //
+  unsigned reference (const void * p) const {
+    const char * c = (const char *) p;
+    assert (base <= c), assert (c < base + 2*half);
+    const size_t offset = c - base;
+    assert (!(offset & 7));
+    return offset >> 3;
+  }
+
+  char * dereference (unsigned ref) const {
+    return base + ((size_t) ref << 3);
+  }
+
+#endif
 };
 
 }
@@ -69,6 +69,34 @@ void Internal::update_target_and_best () {
 
 /*------------------------------------------------------------------------*/
 
+// Trail saving following the SAT'20 paper by Hickey and Bacchus.  During
+// backtracking in search the unassigned literals are saved in trail order
+// together with their reasons on 'saved_trail'.  Propagation frequently
+// derives most of them again in the same order.  Thus 'propagate' replays
+// the saved trail lazily (see 'replay_saved_trail' in 'propagate.cpp') as
+// long as it stays consistent with the current assignment, which saves
+// visiting the watches which would otherwise have to be traversed to find
+// the reasons again.  The saved trail is only valid until the next
+// backtrack and until the next garbage collection, which might delete or
+// move the saved reasons.  Since the next conflict usually happens before
+// the undone decisions are made again, only few saved literals are
+// replayed in practice and thus trail saving is disabled by default.
+
+inline bool Internal::saving_trail () const {
+  return opts.trailsave &&
+         in_mode (SEARCH) && !in_mode (SIMPLIFY) && !in_mode (WALK) &&
+         !searching_lucky_phases && !lookingahead;
+}
+
+void Internal::clear_saved_trail () {
+  if (saved_trail.empty ()) return;
+  LOG ("clearing saved trail of %zd literals", saved_trail.size ());
+  saved_trail.clear ();
+  saved_replayed = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 void Internal::backtrack (int new_level) {
 
   assert (new_level <= level);
@@ -87,10 +115,14 @@ void Internal::backtrack (int new_level) {
 
   int reassigned = 0, unassigned = 0;
 
+  const bool save = saving_trail ();
+  if (save) saved_trail.clear (), saved_replayed = 0;
+
   while (i < end_of_trail) {
     int lit = trail[i++];
     Var & v = var (lit);
     if (v.level > new_level) {
+      if (save) saved_trail.push_back (Saved (lit, v.reason));
       unassign (lit);
       unassigned++;
     } else {
@@ -109,6 +141,7 @@ void Internal::backtrack (int new_level) {
     }
   }
   trail.resize (j);
+  if (save) stats.trailsave.saved += unassigned;
   LOG ("unassigned %d literals %.0f%%",
     unassigned, percent (unassigned, unassigned + reassigned));
   LOG ("reassigned %d literals %.0f%%",
@@ -670,6 +670,7 @@ bool Internal::block () {
   if (unsat) return false;
   if (!stats.current.irredundant) return false;
   if (terminated_asynchronously ()) return false;
+  if (lim.memory.pressure) return false;
 
   if (propagated < trail.size ()) {
     LOG ("need to propagate %zd units first", trail.size () - propagated);
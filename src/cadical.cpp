@@ -24,6 +24,7 @@ namespace CaDiCaL {
 class App : public Handler, public Terminator {
 
   Solver * solver;                // Global solver.
+  ParallelSolver * portfolio;     // Parallel solvers ('--threads').
 
 #ifndef __WIN32
   // Command line options.
@@ -54,6 +55,7 @@ class App : public Handler, public Terminator {
   //
   void print_usage (bool all = false);
   void print_witness (FILE *);
+  int val (int lit);
 
 #ifndef QUIET
   void signal_message (const char * msg, int sig);
@@ -145,6 +147,9 @@ void App::print_usage (bool all) {
 "\n"
 "  -o <output>    write simplified CNF in DIMACS format to file\n"
 "  -e <extend>    write reconstruction/extension stack to file\n"
+"  --icnf <out>   write cubes of depth '--cubes' as iCNF file\n"
+"\n"
+"  --threads <n>  solve with a portfolio of 'n' parallel solvers\n"
 #ifdef LOGGING
 "  -l             enable logging messages (same as '--log')\n"
 #endif
@@ -253,7 +258,7 @@ void App::print_witness (FILE * file) {
   do {
     if (!c) fputc ('v', file), c = 1;
     if (i++ == max_var) tmp = 0;
-    else tmp = solver->val (i) < 0 ? -i : i;
+    else tmp = val (i) < 0 ? -i : i;
     char str[20];
     sprintf (str, " %d", tmp);
     int l = strlen (str);
@@ -264,6 +269,10 @@ void App::print_witness (FILE * file) {
   if (c) fputc ('\n', file);
 }
 
+int App::val (int lit) {
+  return portfolio ? portfolio->val (lit) : solver->val (lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 // Wrapper around option setting.
@@ -340,12 +349,13 @@ int App::main (int argc, char ** argv) {
   const char * dimacs_path = 0, * proof_path = 0;
   bool proof_specified = false, dimacs_specified = false;
   int optimize = 0, preprocessing = 0, localsearch = 0;
-  const char * output_path = 0, * extension_path = 0;
-  int conflict_limit = -1, decision_limit = -1;
+  const char * output_path = 0, * extension_path = 0, * icnf_path = 0;
+  int conflict_limit = -1, decision_limit = -1, threads = 1;
   const char * conflict_limit_specified = 0;
   const char * decision_limit_specified = 0;
   const char * localsearch_specified = 0;
   const char * time_limit_specified = 0;
+  const char * threads_specified = 0;
   bool witness = true, less = false;
   const char * dimacs_name, * err;
 
@@ -384,6 +394,18 @@ int App::main (int argc, char ** argv) {
       else if (!File::writable (argv[i]))
         APPERR ("output file '%s' not writable", argv[i]);
       else output_path = argv[i];
+    } else if (!strcmp (argv[i], "--icnf")) {
+      if (++i == argc) APPERR ("argument to '--icnf' missing");
+      else if (icnf_path)
+        APPERR ("multiple iCNF file options '--icnf %s' and '--icnf %s'",
+          icnf_path, argv[i]);
+      else if (!force_writing &&
+               most_likely_existing_cnf_file (argv[i]))
+        APPERR ("iCNF file '%s' most likely existing CNF (use '-f')",
+                argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("iCNF file '%s' not writable", argv[i]);
+      else icnf_path = argv[i];
     } else if (!strcmp (argv[i], "-e")) {
       if (++i == argc) APPERR ("argument to '-e' missing");
       else if (extension_path)
@@ -436,6 +458,16 @@ int App::main (int argc, char ** argv) {
       else if (decision_limit < 0)
         APPERR ("invalid decision limit");
       else decision_limit_specified = argv[i];
+    } else if (!strcmp (argv[i], "--threads")) {
+      if (++i == argc) APPERR ("argument to '--threads' missing");
+      else if (threads_specified)
+        APPERR ("multiple thread options '--threads %s' and '--threads %s'",
+          threads_specified, argv[i]);
+      else if (!parse_int_str (argv[i], threads))
+        APPERR ("invalid argument in '--threads %s'", argv[i]);
+      else if (threads < 1)
+        APPERR ("invalid number of threads");
+      else threads_specified = argv[i];
     }
 #ifndef __WIN32
     else if (!strcmp (argv[i], "-t")) {
@@ -527,6 +559,15 @@ int App::main (int argc, char ** argv) {
       !strcmp (dimacs_path, proof_path) && strcmp (dimacs_path, "-"))
     APPERR ("DIMACS input file '%s' also specified as DRAT proof file",
       dimacs_path);
+  if (threads > 1 && proof_specified)
+    APPERR ("can not combine '--threads %s' with DRAT proof",
+      threads_specified);
+  if (threads > 1 && icnf_path)
+    APPERR ("can not combine '--threads %s' with '--icnf %s'",
+      threads_specified, icnf_path);
+  if (icnf_path && get ("cubes") <= 0)
+    APPERR ("'--icnf %s' requires a positive cube depth '--cubes=<depth>'",
+      icnf_path);
 
   /*----------------------------------------------------------------------*/
   // The '--less' option is not fully functional yet (it is also not
@@ -642,6 +683,12 @@ int App::main (int argc, char ** argv) {
     err = solver->read_dimacs(stdin, dimacs_name, max_var, force_strict_parsing,
                             incremental, cube_literals);
   if (err) APPERR ("%s", err);
+  if (threads > 1 && incremental)
+    APPERR ("can not combine '--threads %s' with incremental input",
+      threads_specified);
+  if (icnf_path && incremental)
+    APPERR ("can not combine '--icnf %s' with incremental input",
+      icnf_path);
   if (read_solution_path) {
     solver->section ("parsing solution");
     solver->message ("reading solution file from '%s'", read_solution_path);
@@ -775,6 +822,27 @@ int App::main (int argc, char ** argv) {
 
     if (inconclusive && res == 20)
       res = 0;
+  } else if (threads > 1) {
+    solver->section ("solving");
+    solver->message (
+      "solving with %d parallel solvers (due to '--threads %s')",
+      threads, threads_specified);
+    portfolio = new ParallelSolver (threads, solver);
+    if (preprocessing > 0) portfolio->limit ("preprocessing", preprocessing);
+    if (localsearch > 0) portfolio->limit ("localsearch", localsearch);
+    if (conflict_limit >= 0) portfolio->limit ("conflicts", conflict_limit);
+    if (decision_limit >= 0) portfolio->limit ("decisions", decision_limit);
+#ifndef __WIN32
+    if (time_limit >= 0) portfolio->connect_terminator (this);
+#endif
+    res = portfolio->solve ();
+  } else if (icnf_path) {
+    const int depth = get ("cubes");
+    solver->section ("generating cubes");
+    solver->message ("writing cubes of depth %d to iCNF file %s'%s'%s",
+      depth, tout.green_code (), icnf_path, tout.normal_code ());
+    err = solver->write_cubes (icnf_path, depth);
+    if (err) APPERR ("%s", err);
   } else {
     solver->section ("solving");
     res = solver->solve ();
@@ -822,7 +890,8 @@ int App::main (int argc, char ** argv) {
   fflush (write_result_file);
   if (write_result_path)
     fclose (write_result_file);
-  solver->statistics ();
+  if (portfolio) portfolio->statistics ();
+  else solver->statistics ();
   solver->resources ();
   solver->section ("shutting down");
   solver->message ("exit %d", res);
@@ -867,11 +936,12 @@ void App::init () {
 
 /*------------------------------------------------------------------------*/
 
-App::App () : solver (0) { }      // Only partially initialize the app.
+App::App () : solver (0), portfolio (0) { }   // Only partially initialize.
 
 App::~App () {
   if (!solver) return;            // Only partially initialized.
   Signal::reset ();
+  delete portfolio;
   delete solver;
 }
 
@@ -897,7 +967,8 @@ void App::catch_signal (int sig) {
     signal_message ("caught", sig);
     solver->section ("result");
     solver->message ("UNKNOWN");
-    solver->statistics ();
+    if (portfolio) portfolio->statistics ();
+    else solver->statistics ();
     solver->resources ();
     solver->message ();
     signal_message ("raising", sig);
@@ -187,14 +187,18 @@ enum State
 class File;
 struct Internal;
 struct External;
+struct Portfolio;
+struct Worker;
 
 /*------------------------------------------------------------------------*/
 
 // Forward declaration of call-back classes. See bottom of this file.
 
 class Learner;
+class BatchLearner;
 class Terminator;
 class ClauseIterator;
+class CubeIterator;
 class WitnessIterator;
 class LearnSource;
 
@@ -285,6 +289,19 @@ public:
   void connect_learner (Learner * learner);
   void disconnect_learner ();
 
+  // Add call-back which receives buffered learned clauses in batches at
+  // restarts and at the end of search (see 'BatchLearner' below).  Only
+  // units and clauses with at most 'max_size' literals and glue at most
+  // 'max_glue' are buffered.  There can only be one batch learner and it
+  // is independent of the learner connected through 'connect_learner'.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_batch_learner (BatchLearner * learner,
+                              int max_size, int max_glue);
+  void disconnect_batch_learner ();
+
   void connect_learn_source (LearnSource * learnSource);
   void disconnect_learn_source ();
 
@@ -296,7 +313,8 @@ public:
     // monitoring of internally imported / discarded clauses
     unsigned long imported;
     unsigned long discarded;
-    unsigned long r_wit,r_el,r_fx;
+    unsigned long r_wit,r_el,r_fx,r_dup;
+    unsigned long e_dup;
   };
   Statistics get_stats ();
 
@@ -321,6 +339,20 @@ public:
 
   CubesWithStatus generate_cubes(int, int min_depth = 0);
 
+  // Streaming version of 'generate_cubes' which gives each cube to the
+  // iterator as soon as it is generated instead of collecting all cubes
+  // first.  Thus solving cubes can start while cubes are still generated.
+  // Cubes are generated depth-first and generation stops early if 'cube'
+  // returns false.  The result is the status of the formula, which is
+  // non-zero if it was solved while generating cubes.  As for the version
+  // above the state is not changed, thus neither 'val' nor 'failed' can be
+  // used afterwards, even if the formula was solved.
+  //
+  //   require (VALID | SOLVING)
+  //   ensure (VALID | SOLVING)           // state unchanged
+  //
+  int generate_cubes (int depth, CubeIterator &, int min_depth = 0);
+
   void reset_assumptions();
 
   // Return the current state of the solver as defined above.
@@ -356,6 +388,21 @@ public:
   //
   void copy (Solver & other) const;
 
+  // Return a fresh deep clone of 'this' allocated with 'new', which has to
+  // be deleted by the caller.  In contrast to 'copy' it also copies learned
+  // clauses, variable scores, the decision queue, saved phases and internal
+  // statistics.  The clone continues the search exactly where 'this' would
+  // after backtracking to the root level.  Neither assumptions, nor
+  // call-backs (terminator, learner, learn source) nor proof tracing are
+  // cloned.
+  //
+  //   require (READY)          // for 'this'
+  //   ensure (READY)           // for 'this'
+  //
+  //   clone->ensure (UNKNOWN)
+  //
+  Solver * clone () const;
+
   /*----------------------------------------------------------------------*/
   // Variables are usually added and initialized implicitly whenever a
   // literal is used as an argument except for the functions 'val', 'fixed',
@@ -473,13 +520,15 @@ public:
   void optimize (int val);
 
   // Specify search limits, where currently 'name' can be "conflicts",
-  // "decisions", "preprocessing", or "localsearch".  The first two limits
-  // are unbounded by default.  Thus using a negative limit for conflicts or
-  // decisions switches back to the default of unlimited search (for that
-  // particular limit).  The preprocessing limit determines the number of
-  // preprocessing rounds, which is zero by default.  Similarly, the local
-  // search limit determines the number of local search rounds (also zero by
-  // default).  As with 'set', the return value denotes whether the limit
+  // "decisions", "preprocessing", "localsearch" or "memory".  The first two
+  // limits are unbounded by default.  Thus using a negative limit for
+  // conflicts or decisions switches back to the default of unlimited search
+  // (for that particular limit).  The preprocessing limit determines the
+  // number of preprocessing rounds, which is zero by default.  Similarly,
+  // the local search limit determines the number of local search rounds
+  // (also zero by default).  The memory limit in MB overrides the option
+  // 'memorylimit' (by default '0', i.e., unlimited) and if exceeded 'solve'
+  // returns zero.  As with 'set', the return value denotes whether the limit
   // 'name' is valid.  These limits are only valid for the next 'solve' or
   // 'simplify' call and reset to their default after 'solve' returns (as
   // well as overwritten and reset during calls to 'simplify' and
@@ -691,6 +740,19 @@ public:
   //
   const char * write_extension (const char * path);
 
+  // Write current irredundant clauses as for 'write_dimacs' but with an
+  // iCNF 'p inccnf' header, followed by the cubes of 'generate_cubes' as
+  // 'a <lits> 0' lines.  Each cube is written and flushed as soon as it is
+  // generated, so the file can be read while it is still being written.
+  // If no cube is generated since the formula is solved the empty cube
+  // is written.  The result is an error message as for 'write_dimacs'.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  const char * write_cubes (const char * path, int depth,
+                            int min_depth = 0);
+
   // Print build configuration to a file with prefix 'c '.  If the file
   // is '<stdout>' or '<stderr>' then terminal color codes might be used.
   //
@@ -775,6 +837,8 @@ private:
   friend class App;
   friend class Mobical;
   friend class Parser;
+  friend class ParallelSolver;
+  friend struct Worker;
 
   // Read solution in competition format for debugging and testing.
   //
@@ -820,6 +884,14 @@ private:
                             bool * incremental = 0,
                             std::vector<int> * = 0);
 
+  // Bulk version of 'add' for the parser, which adds the zero terminated
+  // clauses of a chunk parsed in parallel at once.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void add_clauses (const std::vector<int> &);
+
   // Factored out common code for 'solve', 'simplify' and 'lookahead'.
   //
   int call_external_solve_and_check_results (bool preprocess_only);
@@ -839,6 +911,89 @@ private:
 
 /*========================================================================*/
 
+// A portfolio of solvers running in parallel threads on the same formula.
+// The workers are diversified (random seed and search configuration) and
+// share short learned clauses with small glue (see options 'share...')
+// through lock-free ring buffers, one for each pair of workers.  As soon
+// as one worker finishes the others are terminated.  This is a thin layer
+// on top of the 'Learner', 'LearnSource' and 'Terminator' interfaces of
+// the workers.  Assumptions, constraints and proof tracing are not
+// supported, but single workers can be accessed through 'worker (...)'.
+// Alternatively the workers can split the formula into cubes and solve
+// them in a cube-and-conquer style (see 'conquer').
+//
+// If the library is configured with '--no-threads' only the first worker
+// is used.
+
+class ParallelSolver {
+
+public:
+
+  // Generates 'threads' workers.  If 'base' is not zero its options and
+  // formula (including the extension stack and frozen variables) are
+  // copied to each worker as in 'Solver::copy' before diversification.
+  //
+  //   require (threads > 0 && (!base || base is READY))
+  //
+  ParallelSolver (int threads, const Solver * base = 0);
+  ~ParallelSolver ();
+
+  int threads () const;
+  Solver * worker (int idx);            // require (0 <= idx < threads)
+
+  // These are forwarded to all workers (see 'Solver' for the contracts).
+  //
+  bool set (const char * name, int val);
+  bool limit (const char * name, int val);
+  void add (int lit);
+
+  // Solve in parallel and return the result of the first worker which
+  // finished ('10' or '20') or '0' if all workers were terminated.  If
+  // the option 'cubes' is non-zero this is the same as 'conquer (cubes)'.
+  //
+  int solve ();
+
+  // Cube-and-conquer.  The first worker splits the formula with
+  // 'generate_cubes (depth)' into cubes, which are distributed over the
+  // workers and solved under assumptions.  Idle workers steal cubes from
+  // the others.  Negated failed assumptions of refuted cubes are added to
+  // all workers.  A cube not solved within its conflict limit (initially
+  // 'cubelimit') is split again on the variable with the highest score in
+  // the worker and both new cubes get twice the limit.  The result is '10'
+  // if some cube is satisfiable and '20' if all cubes are refuted.  Global
+  // conflict and decision limits are ignored.
+  //
+  //   require (depth >= 0)
+  //
+  int conquer (int depth);
+
+  // The worker which determined the result of the last 'solve' (or zero).
+  // Values of literals are taken from this worker.
+  //
+  Solver * winner ();
+  int val (int lit);                    // require (SATISFIED)
+
+  // Asynchronous termination of all workers.  A connected terminator is
+  // only checked by the first worker.
+  //
+  void terminate ();
+  void connect_terminator (Terminator *);
+  void disconnect_terminator ();
+
+  // Print clause sharing statistics and statistics of the winner.
+  //
+  void statistics ();
+
+private:
+
+  Portfolio * portfolio;
+
+  void connect_workers ();
+  int run_workers (void (Worker::*) ());
+};
+
+/*========================================================================*/
+
 // Connected terminators are checked for termination regularly.  If the
 // 'terminate' function of the terminator returns true the solver is
 // terminated synchronously as soon it calls this function.
@@ -861,11 +1016,43 @@ public:
   virtual void learn (int lit) = 0;
 };
 
+// Batch learners receive learned clauses without a virtual call per
+// literal or clause on the conflict path.  The solver buffers externalized
+// learned clauses and flushes them as one flat buffer from 'begin' to 'end'
+// in the batch format of 'LearnSource::getNextClauses' below, i.e., each
+// clause is given by its glue (zero for units) followed by its literals and
+// terminated by zero.  The buffer is only valid during the call.  The empty
+// clause is not exported.
+
+class BatchLearner {
+public:
+  virtual ~BatchLearner () { }
+  virtual void learn (const int * begin, const int * end) = 0;
+};
+
+// Connected learn sources provide clauses to be imported as redundant
+// clauses (during search before decisions at any decision level).  Single
+// clauses are given as the unit literal or as glue followed by the
+// literals of the clause.  Since 'hasNextClause' is checked before every
+// decision it should be cheap.
+//
+// Alternatively 'getNextClauses' can provide a whole batch of clauses in
+// one flat buffer from 'begin' to 'end', in which each clause is given by
+// its glue (ignored for units) followed by its literals and terminated by
+// zero.  The solver imports the batch in place and the buffer only has to
+// remain valid until the next call.  Batches are requested first until
+// 'getNextClauses' returns false.  The solver only starts importing if
+// 'hasNextClause' returns true, thus it should also consider batches.
+
 class LearnSource {
 public:
   virtual ~LearnSource () { }
   virtual bool hasNextClause () = 0;
   virtual const std::vector<int>& getNextClause () = 0;
+  virtual bool getNextClauses (const int *& begin, const int *& end) {
+    (void) begin, (void) end;
+    return false;
+  }
 };
 
 /*------------------------------------------------------------------------*/
@@ -885,6 +1072,17 @@ public:
 
 /*------------------------------------------------------------------------*/
 
+// Receives the cubes of the streaming 'generate_cubes'.  The cube is only
+// valid during the call.  If 'cube' returns false generation stops.
+
+class CubeIterator {
+public:
+  virtual ~CubeIterator () { }
+  virtual bool cube (const std::vector<int> &) = 0;
+};
+
+/*------------------------------------------------------------------------*/
+
 // Allows to traverse all clauses on the extension stack together with their
 // witness cubes.  If the solver is inconsistent, i.e., an empty clause is
 // found and the formula is unsatisfiable, then nothing is traversed.
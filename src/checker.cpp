@@ -162,6 +162,24 @@ void Checker::collect_garbage_clauses () {
 
 /*------------------------------------------------------------------------*/
 
+// Only used for enforcing 'opts.memorylimit' and thus does not need to be
+// fast nor precise (garbage clauses do not have a size anymore).
+
+size_t Checker::bytes () const {
+  size_t res = size_clauses * sizeof (CheckerClause *);
+  res += 2 * size_vars * (sizeof (signed char) + sizeof (CheckerWatcher));
+  for (size_t i = 0; i < size_clauses; i++)
+    for (CheckerClause * c = clauses[i]; c; c = c->next)
+      res += sizeof (CheckerClause) + (c->size - 2) * sizeof (int);
+  for (CheckerClause * c = garbage; c; c = c->next)
+    res += sizeof (CheckerClause);
+  for (const auto & ws : watchers)
+    res += ws.capacity () * sizeof (CheckerWatch);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 Checker::Checker (Internal * i)
 :
   internal (i),
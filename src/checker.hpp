@@ -158,6 +158,8 @@ public:
 
   void print_stats ();
   void dump ();                 // for debugging purposes only
+
+  size_t bytes () const;        // estimated allocated memory
 };
 
 }
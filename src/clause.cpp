@@ -84,7 +84,14 @@ Clause * Internal::new_clause (bool red, int glue) {
   else keep = false;
 
   size_t bytes = Clause::bytes (size);
-  Clause * c = (Clause *) new char[bytes];
+#ifdef WATCH32
+  Clause * c = (Clause *) arena.allocate (bytes);
+#else
+  Clause * c = 0;
+  if (red && opts.arena && opts.arenanursery && !lim.memory.pressure)
+    c = (Clause *) arena.allocate_nursery (bytes);
+  if (!c) c = (Clause *) new char[bytes];
+#endif
 
   stats.added.total++;
 #ifdef LOGGING
@@ -109,9 +116,10 @@ Clause * Internal::new_clause (bool red, int glue) {
   c->vivify = false;
   c->used = 0;
 
+  if (glue > Clause::max_glue) glue = Clause::max_glue;
   c->glue = glue;
   c->size = size;
-  c->pos = 2;
+  c->save_pos (2);
 
   for (int i = 0; i < size; i++) c->literals[i] = clause[i];
 
@@ -130,6 +138,7 @@ Clause * Internal::new_clause (bool red, int glue) {
     stats.irrbytes += bytes;
     stats.current.irredundant++;
     stats.added.irredundant++;
+    if (counting_loccs ()) inc_loccs (c);
   }
 
   clauses.push_back (c);
@@ -186,10 +195,11 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
     c->literals[i] = 0;
 #endif
 
-  if (c->pos >= new_size) c->pos = 2;
+  const int pos = c->saved_pos ();
 
   size_t old_bytes = c->bytes ();
   c->size = new_size;
+  c->save_pos (pos < new_size ? pos : 2);
   size_t new_bytes = c->bytes ();
   size_t res = old_bytes - new_bytes;
 
@@ -205,12 +215,15 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
 }
 
 // This is the 'raw' deallocation of a clause.  If the clause is in the
-// arena nothing happens.  If the clause is not in the arena its memory is
-// reclaimed immediately.
+// arena (or its young generation) nothing happens.  If the clause is not in the
+// arena its memory is reclaimed immediately.
 
 void Internal::deallocate_clause (Clause * c) {
   char * p = (char*) c;
   if (arena.contains (p)) return;
+#ifndef WATCH32
+  if (arena.young_contains (p)) return;
+#endif
   LOG (c, "deallocate pointer %p", (void*) c);
   delete [] p;
 }
@@ -229,9 +242,10 @@ void Internal::delete_clause (Clause * c) {
     // actually deleted here.  This allows the solver to propagate binary
     // garbage clauses without producing incorrect 'd' lines.  The effect
     // from the proof perspective is that the deletion of these binary
-    // clauses occurs later in the proof file.
+    // clauses occurs later in the proof file.  The same applies to ternary
+    // clauses with their inline watches (see 'watch.hpp').
     //
-    if (proof && c->size == 2)
+    if (proof && c->size <= 3)
       proof->delete_clause (c);
   }
   deallocate_clause (c);
@@ -257,10 +271,11 @@ void Internal::mark_garbage (Clause * c) {
 
   assert (!c->garbage);
 
-  // Delay tracing deletion of binary clauses.  See the discussion above in
-  // 'delete_clause' and also in 'propagate'.
+  // Delay tracing deletion of binary and ternary clauses (the latter are
+  // propagated without accessing the clause too, see 'watch.hpp').  See
+  // the discussion above in 'delete_clause' and also in 'propagate'.
   //
-  if (proof && c->size != 2)
+  if (proof && c->size > 3)
     proof->delete_clause (c);
 
   assert (stats.current.total > 0);
@@ -281,6 +296,8 @@ void Internal::mark_garbage (Clause * c) {
   c->garbage = true;
   c->used = 0;
 
+  if (!c->redundant && counting_loccs ()) dec_loccs (c);
+
   LOG (c, "marked garbage pointer %p", (void*) c);
 }
 
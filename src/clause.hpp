@@ -21,6 +21,14 @@ typedef const int * const_literal_iterator;
 // to store the actual literals somewhere else, which not only needs more
 // memory but more importantly also requires another memory access and thus
 // is very costly.
+//
+// The header of a clause is packed into 8 bytes (without 'id' used for
+// logging).  All flags and the 'glue' share the first 32-bit word and the
+// 'size' is the second word.  The saved position 'pos' of the last watch
+// replacement is only stored for clauses of size at least 'min_pos_size'
+// and then kept after the last literal (see 'saved_pos' below).  Thus
+// binary clauses only need 16 bytes and ternary clauses 24 bytes, which
+// is a substantial saving since these are the most frequent clauses.
 
 struct Clause {
 #ifdef LOGGING
@@ -79,10 +87,15 @@ struct Clause {
   // See 'mark_useless_redundant_clauses_as_garbage' in 'reduce.cpp' and
   // 'bump_clause' in 'analyze.cpp'.
   //
-  int glue;
+  // In order to fit it into the header together with the flags, the glue
+  // is capped at 'max_glue', which is way beyond all the tier limits.
+  //
+  int glue:14;
 
   int size;         // Actual size of 'literals' (at least 2).
-  int pos;          // Position of last watch replacement [Gent'13].
+
+  static const int max_glue = (1 << 13) - 1;
+  static const int min_pos_size = 5;
 
   union {
 
@@ -102,6 +115,19 @@ struct Clause {
   const_literal_iterator begin () const { return literals; }
   const_literal_iterator   end () const { return literals + size; }
 
+  // Position of last watch replacement [Gent'13].  It is only saved for
+  // long clauses, where it is stored right after the last literal.  For
+  // shorter clauses searching for a replacement always starts at the first
+  // non-watched literal.
+  //
+  int saved_pos () const {
+    return size < min_pos_size ? 2 : *end ();
+  }
+
+  void save_pos (int pos) {
+    if (size >= min_pos_size) *end () = pos;
+  }
+
   static size_t bytes (int size) {
 
     // Memory sanitizer insists that clauses put into consecutive memory in
@@ -111,7 +137,8 @@ struct Clause {
     // all the time (even if allocated outside of the arena).
     //
     assert (size > 1);
-    return align ((size - 2) * sizeof (int) + sizeof (Clause), 8);
+    const int extra = (size >= min_pos_size);   // for 'pos'
+    return align ((size - 2 + extra) * sizeof (int) + sizeof (Clause), 8);
   }
 
   size_t bytes () const { return bytes (size); }
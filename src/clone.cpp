@@ -0,0 +1,136 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Deep copy of the solver state for 'Solver::clone'.  In contrast to
+// 'Solver::copy', which only adds irredundant clauses and witnesses to an
+// empty solver through the API, this function copies all variable tables,
+// including flags, scores, the decision queue, phases and the extension
+// stack, as well as learned clauses.  The clauses are copied as raw memory
+// into the arena of the clone exactly as the moving garbage collector does
+// (see 'copy_non_garbage_clauses' in 'collect.cpp').  Only the root level
+// assignment is copied and the watches are connected from scratch.  Proof
+// tracing, call-backs and assumptions are not copied.
+
+template<class T> static void
+copy_prefix (const vector<T> & src, vector<T> & dst, size_t size) {
+  assert (size <= src.size ());
+  assert (size <= dst.size ());
+  std::copy (src.begin (), src.begin () + size, dst.begin ());
+}
+
+void Internal::clone (Internal & dst) const {
+
+  assert (!dst.max_var);
+  assert (dst.clauses.empty ());
+  assert (!dst.proof);
+
+  opts.copy (dst.opts);
+  dst.init_vars (max_var);              // Allocates all variable tables.
+
+  // The source tables might have been allocated larger than those of the
+  // clone, thus we only copy the used prefixes (nothing is allocated yet
+  // without variables).
+  //
+  const size_t size = max_var ? 1 + (size_t) max_var : 0;
+  dst.i2e = i2e;
+  copy_prefix (frozentab, dst.frozentab, size);
+  copy_prefix (ftab, dst.ftab, size);
+  copy_prefix (vtab, dst.vtab, size);
+  copy_prefix (btab, dst.btab, size);
+  copy_prefix (gtab, dst.gtab, size);
+  copy_prefix (stab, dst.stab, size);
+  copy_prefix (links, dst.links, size);
+  copy_prefix (ptab, dst.ptab, 2*size);
+  copy_prefix (phases.best, dst.phases.best, size);
+  copy_prefix (phases.forced, dst.phases.forced, size);
+  copy_prefix (phases.min, dst.phases.min, size);
+  copy_prefix (phases.prev, dst.phases.prev, size);
+  copy_prefix (phases.saved, dst.phases.saved, size);
+  copy_prefix (phases.target, dst.phases.target, size);
+  dst.queue = queue;
+  dst.score_inc = score_inc;
+  dst.scores.copy (scores);
+  dst.probes = probes;
+
+  // Copy root level assignments only, since there might still be the
+  // satisfying assignment of the last 'solve' call on higher levels.
+  //
+  for (const auto & lit : trail) {
+    const int idx = abs (lit);
+    if (vtab[idx].level) continue;
+    Var & v = dst.vtab[idx];
+    v.trail = (int) dst.trail.size ();
+    v.reason = 0;
+    dst.vals[lit] = 1;
+    dst.vals[-lit] = -1;
+    dst.trail.push_back (lit);
+  }
+
+  // Variables assigned above the root level have to be put back to the
+  // queue and the heap as during backtracking.
+  //
+  if (level) {
+    dst.update_queue_unassigned (dst.queue.last);
+    for (auto idx : vars)
+      if (!dst.vals[idx] && !dst.scores.contains (idx))
+        dst.scores.push_back (idx);
+  }
+
+  // Copy all non-garbage clauses in one contiguous chunk of the arena.
+  //
+  size_t bytes = 0;
+  for (const auto & c : clauses)
+    if (!c->garbage) bytes += c->bytes ();
+  dst.arena.prepare (bytes);
+  dst.clauses.reserve (stats.current.total);
+  for (const auto & c : clauses) {
+    if (c->garbage) continue;
+    Clause * d = (Clause *) dst.arena.copy ((const char *) c, c->bytes ());
+    d->reason = false;
+    dst.clauses.push_back (d);
+  }
+  dst.arena.swap ();
+
+  // Statistics, limits and averages continue where 'this' stopped, except
+  // that garbage clauses are gone now.
+  //
+  dst.unsat = unsat;
+  dst.stable = stable;
+  dst.rephased = rephased;
+  dst.reluctant = reluctant;
+  dst.best_assigned = best_assigned;
+  dst.target_assigned = target_assigned;
+  dst.averages = averages;
+  dst.lim = lim;
+  dst.last = last;
+  dst.inc = inc;
+  dst.stats = stats;
+  dst.stats.garbage = 0;
+
+  // Finally connect all watches and propagate all root level units again.
+  //
+  assert (watching () == dst.watching ());
+  if (dst.watching ()) dst.connect_watches ();
+  dst.propagated = dst.propagated2 = 0;
+
+}
+
+void External::clone (External & dst) const {
+  assert (!dst.max_var);
+  internal->clone (*dst.internal);
+  dst.max_var = max_var;
+  dst.vsize = vsize;
+  dst.e2i = e2i;
+  dst.extension = extension;
+  dst.witness = witness;
+  dst.tainted = tainted;
+  dst.reprs = reprs;
+  dst.frozentab = frozentab;
+  dst.moltentab = moltentab;
+  dst.original = original;
+}
+
+}
@@ -48,6 +48,7 @@ void Internal::remove_falsified_literals (Clause * c) {
     assert (tmp <= 0);
     if (tmp >= 0) continue;
     LOG ("flushing %d", lit);
+    if (!c->redundant && counting_loccs ()) dec_locc (lit);
     j--;
   }
   stats.collected += shrink_clause (c, j - c->begin ());
@@ -159,30 +160,46 @@ size_t Internal::flush_occs (int lit) {
 // 'reduce' where we watch and no occurrence lists.  We have to protect
 // reason clauses not be collected and thus we have this additional check
 // hidden in 'Clause.collect', which for the root level context of
-// preprocessing is actually redundant.
-
-inline void Internal::flush_watches (int lit, Watches & saved) {
-  assert (saved.empty ());
+// preprocessing is actually redundant.  Long clauses which were shrunken
+// to binary clauses since the last collection have their watches moved
+// over to the binary watch lists.
+
+inline void Internal::flush_watches (int lit) {
+  Watches & bs = binary_watches (lit);
+  {
+    const const_watch_iterator end = bs.end ();
+    watch_iterator j = bs.begin ();
+    const_watch_iterator i;
+    for (i = j; i != end; i++) {
+      const Watch & w = *i;
+      Clause * c = watched_clause (w);
+      if (c->collect ()) continue;
+      if (c->moved) c = c->copy;
+      assert (c->size == 2);
+      const int new_blit_pos = (c->literals[0] == lit);
+      assert (c->literals[!new_blit_pos] == lit);      /*FW1*/
+      *j++ = make_watch (lit, c->literals[new_blit_pos], c);
+    }
+    bs.resize (j - bs.begin ());
+  }
   Watches & ws = watches (lit);
-  const const_watch_iterator end = ws.end ();
-  watch_iterator j = ws.begin ();
-  const_watch_iterator i;
-  for (i = j; i != end; i++) {
-    Watch w = *i;
-    Clause * c = w.clause;
-    if (c->collect ()) continue;
-    if (c->moved) c = w.clause = c->copy;
-    w.size = c->size;
-    const int new_blit_pos = (c->literals[0] == lit);
-    assert (c->literals[!new_blit_pos] == lit);        /*FW1*/
-    w.blit = c->literals[new_blit_pos];
-    if (w.binary ()) *j++ = w;
-    else saved.push_back (w);
+  {
+    const const_watch_iterator end = ws.end ();
+    watch_iterator j = ws.begin ();
+    const_watch_iterator i;
+    for (i = j; i != end; i++) {
+      Watch w = *i;
+      Clause * c = watched_clause (w);
+      if (c->collect ()) continue;
+      if (c->moved) c = c->copy;
+      const int new_blit_pos = (c->literals[0] == lit);
+      assert (c->literals[!new_blit_pos] == lit);      /*FW2*/
+      w = make_watch (lit, c->literals[new_blit_pos], c);
+      if (w.binary ()) watchstore.push_back (bs, w);
+      else *j++ = w;
+    }
+    ws.resize (j - ws.begin ());
   }
-  ws.resize (j - ws.begin ());
-  for (const auto & w : saved) ws.push_back (w);
-  saved.clear ();
-  shrink_vector (ws);
 }
 
 void Internal::flush_all_occs_and_watches () {
@@ -191,9 +208,9 @@ void Internal::flush_all_occs_and_watches () {
       flush_occs (idx), flush_occs (-idx);
 
   if (watching ()) {
-    Watches tmp;
     for (auto idx : vars)
-      flush_watches (idx, tmp), flush_watches (-idx, tmp);
+      flush_watches (idx), flush_watches (-idx);
+    defrag_watches ();
   }
 }
 
@@ -209,7 +226,10 @@ void Internal::update_reason_references () {
     if (!c) continue;
     LOG (c, "updating assigned %d reason", lit);
     assert (c->reason);
-    assert (c->moved);
+    if (!c->moved) {
+      assert (arena.contains (c));      // old clause in minor collection
+      continue;
+    }
     Clause * d = c->copy;
     v.reason = d;
     count++;
@@ -259,7 +279,12 @@ void Internal::copy_clause (Clause * c) {
   LOG (c, "moving");
   assert (!c->moved);
   char * p = (char*) c;
-  char * q = arena.copy (p, c->bytes ());
+  char * q;
+#ifndef WATCH32
+  if (young_clause (c)) q = arena.copy_young (p, c->bytes ());
+  else
+#endif
+  q = arena.copy (p, c->bytes ());
   c->copy = (Clause *) q;
   c->moved = true;
   LOG ("copied clause[%" PRId64 "] from %p to %p",
@@ -272,12 +297,20 @@ void Internal::copy_non_garbage_clauses () {
 
   size_t collected_clauses = 0, collected_bytes = 0;
   size_t     moved_clauses = 0,     moved_bytes = 0;
+#ifndef WATCH32
+  size_t young_bytes = 0;
+#endif
 
   // First determine 'moved_bytes' and 'collected_bytes'.
   //
   for (const auto & c : clauses)
-    if (!c->collect ()) moved_bytes += c->bytes (), moved_clauses++;
-    else collected_bytes += c->bytes (), collected_clauses++;
+    if (!c->collect ()) {
+      moved_bytes += c->bytes (), moved_clauses++;
+#ifndef WATCH32
+      if (opts.arenagen && c->redundant && !c->keep)
+        young_bytes += c->bytes ();
+#endif
+    } else collected_bytes += c->bytes (), collected_clauses++;
 
   PHASE ("collect", stats.collections,
     "moving %zd bytes %.0f%% of %zd non garbage clauses",
@@ -285,9 +318,15 @@ void Internal::copy_non_garbage_clauses () {
     percent (moved_bytes, collected_bytes + moved_bytes),
     moved_clauses);
 
-  // Prepare 'to' space of size 'moved_bytes'.
+  // Prepare 'to' space of size 'moved_bytes' (minus the bytes of young
+  // clauses which in generational mode go to the young space instead).
   //
+#ifndef WATCH32
+  arena.prepare (moved_bytes - young_bytes);
+  if (opts.arenagen) arena.prepare_young (young_bytes);
+#else
   arena.prepare (moved_bytes);
+#endif
 
   // Keep clauses in arena in the same order.
   //
@@ -324,9 +363,10 @@ void Internal::copy_non_garbage_clauses () {
 
     for (int sign = -1; sign <= 1; sign += 2)
       for (auto idx : vars)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+        for (const auto & w : watches (sign * likely_phase (idx))) {
+          Clause * c = watched_clause (w);
+          if (!c->moved && !c->collect ()) copy_clause (c);
+        }
 
   } else {
 
@@ -340,13 +380,16 @@ void Internal::copy_non_garbage_clauses () {
 
     for (int sign = -1; sign <= 1; sign += 2)
       for (int idx = queue.last; idx; idx = link (idx).prev)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+        for (const auto & w : watches (sign * likely_phase (idx))) {
+          Clause * c = watched_clause (w);
+          if (!c->moved && !c->collect ()) copy_clause (c);
+        }
   }
 
-  // Do not forget to move clauses which are not watched, which happened in
-  // a rare situation, and now is only left as defensive code.
+  // Do not forget to move clauses which are not watched.  This includes
+  // all binary clauses, which are only watched in the binary watch lists
+  // and are never accessed during propagation.  Thus we put them at the
+  // end of the arena after all the long clauses.
   //
   for (const auto & c : clauses)
     if (!c->collect () && !c->moved)
@@ -373,6 +416,9 @@ void Internal::copy_non_garbage_clauses () {
   // Release 'from' space completely and then swap 'to' with 'from'.
   //
   arena.swap ();
+#ifndef WATCH32
+  arena.swap_young ();
+#endif
 
   PHASE ("collect", stats.collections,
     "collected %zd bytes %.0f%% of %zd garbage clauses",
@@ -383,6 +429,111 @@ void Internal::copy_non_garbage_clauses () {
 
 /*------------------------------------------------------------------------*/
 
+#ifndef WATCH32
+
+// In generational mode a major collection (see 'arena.hpp') moves
+// tier-two and tier-three learned clauses to the young space.  During a
+// minor collection (where 'to' is not prepared) all moved clauses stay in
+// the young generation.
+
+bool Internal::young_clause (Clause * c) {
+  if (!arena.young_prepared ()) return false;
+  if (!arena.prepared ()) return true;
+  return c->redundant && !c->keep;
+}
+
+// A minor collection suffices unless the old generation diverged too much
+// from its live part, either by garbage clauses in it or by irredundant
+// and tier-one clauses added to the young generation since the last major
+// collection.  Both are measured relative to the size of the old space.
+
+bool Internal::minor_collection () {
+  if (!opts.arenagen) return false;
+  const size_t old_bytes = arena.old_bytes ();
+  if (!old_bytes) return false;
+  if (lim.memory.pressure) return true;        // avoid copying old space
+  size_t live_bytes = 0, promoted_bytes = 0;
+  for (const auto & c : clauses) {
+    if (c->collect ()) continue;
+    if (arena.contains (c)) live_bytes += c->bytes ();
+    else if (!c->redundant || c->keep) promoted_bytes += c->bytes ();
+  }
+  assert (live_bytes <= old_bytes);
+  const size_t diverged = old_bytes - live_bytes + promoted_bytes;
+  const bool res = 100.0 * diverged <= opts.arenagenlim * (double) old_bytes;
+  PHASE ("collect", stats.collections,
+    "old generation diverged by %zd bytes %.0f%% (%s collection)",
+    diverged, percent (diverged, old_bytes), res ? "minor" : "major");
+  return res;
+}
+
+// The minor collection only moves clauses in the young generation and
+// those allocated outside of the arena (but not the old generation).
+
+void Internal::copy_young_clauses () {
+
+  size_t collected_clauses = 0, collected_bytes = 0;
+  size_t     moved_clauses = 0,     moved_bytes = 0;
+
+  for (const auto & c : clauses) {
+    if (arena.contains (c)) continue;
+    if (!c->collect ()) moved_bytes += c->bytes (), moved_clauses++;
+    else collected_bytes += c->bytes (), collected_clauses++;
+  }
+
+  PHASE ("collect", stats.collections,
+    "moving %zd bytes %.0f%% of %zd non garbage young clauses",
+    moved_bytes,
+    percent (moved_bytes, collected_bytes + moved_bytes),
+    moved_clauses);
+
+  arena.prepare_young (moved_bytes);
+
+  // Localize according to decision queue order (as 'opts.arenatype == 3').
+  //
+  if (watching ())
+    for (int sign = -1; sign <= 1; sign += 2)
+      for (int idx = queue.last; idx; idx = link (idx).prev)
+        for (const auto & w : watches (sign * likely_phase (idx))) {
+          Clause * c = watched_clause (w);
+          if (c->moved || c->collect () || arena.contains (c)) continue;
+          copy_clause (c);
+        }
+
+  for (const auto & c : clauses)
+    if (!c->collect () && !c->moved && !arena.contains (c))
+      copy_clause (c);
+
+  flush_all_occs_and_watches ();
+  update_reason_references ();
+
+  // Garbage clauses in the old generation are dropped from 'clauses' too,
+  // but their memory is only reclaimed during the next major collection.
+  //
+  const auto end = clauses.end ();
+  auto j = clauses.begin (), i = j;
+  for (; i != end; i++) {
+    Clause * c = *i;
+    if (c->collect ()) delete_clause (c);
+    else if (c->moved) *j++ = c->copy, deallocate_clause (c);
+    else *j++ = c;
+  }
+  clauses.resize (j - clauses.begin ());
+  if (clauses.size () < clauses.capacity ()/2) shrink_vector (clauses);
+
+  arena.swap_young ();
+
+  PHASE ("collect", stats.collections,
+    "collected %zd bytes %.0f%% of %zd garbage young clauses",
+    collected_bytes,
+    percent (collected_bytes, collected_bytes + moved_bytes),
+    collected_clauses);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 // Maintaining clause statistics is complex and error prone but necessary
 // for proper scheduling of garbage collection, particularly during bounded
 // variable elimination.  With this function we can check whether these
@@ -407,21 +558,35 @@ void Internal::check_clause_stats () {
 /*------------------------------------------------------------------------*/
 
 bool Internal::arenaing () {
+#ifdef WATCH32
+  return true;          // all clauses are in the arena (see 'arena.hpp')
+#else
+  if (arena.young_occupied ()) return true;     // needs to be evacuated
+  if (lim.memory.pressure) return false;        // collect in place
   return opts.arena && (stats.collections > 1);
+#endif
 }
 
 void Internal::garbage_collection () {
+  clear_saved_trail ();               // might contain deleted reasons
   if (unsat) return;
   START (collect);
   report ('G', 1);
   stats.collections++;
   mark_satisfied_clauses_as_garbage ();
   if (!protected_reasons) protect_reasons ();
-  if (arenaing ()) copy_non_garbage_clauses ();
-  else delete_garbage_clauses ();
+  if (!arenaing ()) delete_garbage_clauses ();
+#ifndef WATCH32
+  else if (minor_collection ()) {
+    stats.minorcollections++;
+    copy_young_clauses ();
+  }
+#endif
+  else copy_non_garbage_clauses ();
   check_clause_stats ();
   check_var_stats ();
   unprotect_reasons ();
+  check_memory_limit ();
   report ('C', 1);
   STOP (collect);
 }
@@ -218,9 +218,16 @@ void Internal::compact () {
   // Map the blocking literals in all watches.
   //
   if (!wtab.empty ())
-    for (auto lit : lits)
-      for (auto & w : watches (lit))
+    for (auto lit : lits) {
+      for (auto & w : watches (lit)) {
         w.blit = mapper.map_lit (w.blit);
+#ifndef WATCH32
+        if (w.ternary ()) w.third = mapper.map_lit (w.third);
+#endif
+      }
+      for (auto & w : binary_watches (lit))
+        w.blit = mapper.map_lit (w.blit);
+    }
 
   // We first flush inactive variables and map the links in the queue.  This
   // has to be done before we map the actual links data structure 'links'.
@@ -329,6 +336,7 @@ void Internal::compact () {
   mapper.map_vector (vtab);
   if (!ntab.empty ()) mapper.map2_vector (ntab);
   if (!wtab.empty ()) mapper.map2_vector (wtab);
+  if (!bwtab.empty ()) mapper.map2_vector (bwtab);
   if (!otab.empty ()) mapper.map2_vector (otab);
   if (!big.empty ()) mapper.map2_vector (big);
 
@@ -72,7 +72,7 @@ bool Internal::decompose_round () {
           // Go over all implied literals, thus need to iterate over all
           // binary watched clauses with the negation of 'parent'.
 
-          Watches & ws = watches (-parent);
+          Watches & ws = binary_watches (-parent);
 
           // Two cases: Either the node has never been visited before, i.e.,
           // it's depth first search index is zero, then perform the
@@ -91,7 +91,6 @@ bool Internal::decompose_round () {
             unsigned new_min = parent_dfs.min;
 
             for (const auto & w : ws) {
-              if (!w.binary ()) continue;
               const int child = w.blit;
               if (!active (child)) continue;
               const DFS & child_dfs = dfs[vlit (child)];
@@ -170,7 +169,6 @@ bool Internal::decompose_round () {
             // graph but keep 'parent' on the stack for 'post-fix' work.
 
             for (const auto & w : ws) {
-              if (!w.binary ()) continue;
               const int child = w.blit;
               if (!active (child)) continue;
               const DFS & child_dfs = dfs[vlit (child)];
@@ -273,6 +271,7 @@ bool Internal::decompose_round () {
       LOG ("simply shrinking clause since watches did not change");
       assert (c->size > 2);
       if (!c->redundant) mark_removed (c);
+      if (!c->redundant && counting_loccs ()) dec_loccs (c);
       if (proof) {
         proof->add_derived_clause (clause);
         proof->delete_clause (c);
@@ -286,6 +285,7 @@ bool Internal::decompose_round () {
         LOG ("flushed %d literals", flushed);
         (void) shrink_clause (c, l);
       } else if (likely_to_be_kept_clause (c)) mark_added (c);
+      if (!c->redundant && counting_loccs ()) inc_loccs (c);
       LOG (c, "substituted");
     }
     while (!clause.empty ()) {
@@ -334,7 +334,10 @@ bool Internal::decompose_round () {
     if (other == idx) continue;
     assert (!flags (other).eliminated ());
     assert (!flags (other).substituted ());
-    if (!flags (other).fixed ()) mark_substituted (idx);
+    if (!flags (other).fixed ()) {
+      mark_substituted (idx);
+      external->substitute (idx, other);
+    }
     external->push_binary_clause_on_extension_stack (-idx, other);
     external->push_binary_clause_on_extension_stack (idx, -other);
   }
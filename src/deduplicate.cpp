@@ -6,8 +6,8 @@ namespace CaDiCaL {
 // or 'vivify' might produce duplicated binary clauses.  They can not be
 // found in 'subsume' nor 'vivify' since we explicitly do not consider
 // binary clauses as candidates to be shrunken or subsumed.  They are
-// detected here by a simple scan of watch lists and then marked as garbage.
-// This is actually also quite fast.
+// detected here by a simple scan of binary watch lists and then marked as
+// garbage.  This is actually also quite fast.
 
 // Further it might also be possible that two binary clauses can be resolved
 // to produce a unit (we call it 'hyper unary resolution').  For example
@@ -45,7 +45,7 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
       const int lit = sign * idx;       // Consider all literals.
 
       assert (stack.empty ());
-      Watches & ws = watches (lit);
+      Watches & ws = binary_watches (lit);
 
       // We are removing references to garbage clause. Thus no 'auto'.
 
@@ -55,10 +55,9 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
 
       for (i = j; !unit && i != end; i++) {
         Watch w = *j++ = *i;
-        if (!w.binary ()) continue;
         int other = w.blit;
         const int tmp = marked (other);
-        Clause * c = w.clause;
+        Clause * c = watched_clause (w);
 
         if (tmp > 0) {                  // Found duplicated binary clause.
 
@@ -73,9 +72,8 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
             watch_iterator k;
             for (k = ws.begin ();;k++) {
               assert (k != i);
-              if (!k->binary ()) continue;
               if (k->blit != other) continue;
-              Clause * d = k->clause;
+              Clause * d = watched_clause (*k);
               if (d->garbage) continue;
               c = d;
               break;
@@ -105,7 +103,7 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
         }
       }
 
-      if (j == ws.begin ()) erase_vector (ws);
+      if (j == ws.begin ()) ws.clear ();
       else if (j != end)
         ws.resize (j - ws.begin ());    // Shrink watchers.
 
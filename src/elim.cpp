@@ -58,6 +58,10 @@ bool Internal::eliminating () {
   if (!preprocessing && !opts.inprocessing) return false;
   if (preprocessing) assert (lim.preprocessing);
 
+  // Occurrence lists might not fit into memory (see 'memory.cpp').
+  //
+  if (lim.memory.pressure) return false;
+
   // Respect (increasing) conflict limit.
   //
   if (lim.elim >= stats.conflicts) return false;
@@ -700,6 +704,8 @@ int Internal::elim_round (bool & completed) {
         if (active (lit))
           occs (lit).push_back (c);
 
+  check_memory_limit ();      // Occurrence lists might need a lot.
+
 #ifndef QUIET
   const int64_t old_resolutions = stats.elimres;
 #endif
@@ -829,6 +835,8 @@ void Internal::elim (bool update_limits) {
   if (level) backtrack ();
   if (!propagate ()) { learn_empty_clause (); return; }
 
+  check_memory_limit ();
+
   stats.elimphases++;
   PHASE ("elim-phase", stats.elimphases,
     "starting at most %d elimination rounds",
@@ -11,6 +11,9 @@ External::External (Internal * i)
   terminator (0),
   learner (0),
   learnSource (0),
+  batch_learner (0),
+  batch_size (0),
+  batch_glue (0),
   solution (0),
   vars (max_var)
 {
@@ -107,6 +110,7 @@ int External::internalize (int elit) {
       internal->i2e.push_back (eidx);
       assert (internal->i2e[ilit] == eidx);
       assert (e2i[eidx] == ilit);
+      if (eidx < (int) reprs.size ()) reprs[eidx] = 0;
       if (elit < 0) ilit = -ilit;
     }
     if (internal->opts.checkfrozen) {
@@ -117,7 +121,10 @@ int External::internalize (int elit) {
     Flags & f = internal->flags (ilit);
     if (f.status == Flags::UNUSED) internal->mark_active (ilit);
     else if (f.status != Flags::ACTIVE &&
-             f.status != Flags::FIXED) internal->reactivate (ilit);
+             f.status != Flags::FIXED) {
+      internal->reactivate (ilit);
+      if (eidx < (int) reprs.size ()) reprs[eidx] = 0;
+    }
     if (!marked (tainted, elit) && marked (witness, -elit)) {
       assert (!internal->opts.checkfrozen);
       LOG ("marking tainted %d", elit);
@@ -139,6 +146,22 @@ void External::add (int elit) {
   internal->add_original_lit (ilit);
 }
 
+// Same as calling 'add' for each literal.  Only used by the parser.
+
+void External::add (const int * lits, size_t size) {
+  reset_extended ();
+  const bool keep = internal->opts.check &&
+    (internal->opts.checkwitness || internal->opts.checkfailed);
+  for (const int * p = lits; p != lits + size; p++) {
+    const int elit = *p;
+    assert (elit != INT_MIN);
+    if (keep) original.push_back (elit);
+    const int ilit = internalize (elit);
+    assert (!elit == !ilit);
+    internal->add_original_lit (ilit);
+  }
+}
+
 void External::assume (int elit) {
   assert (elit);
   reset_extended ();
@@ -257,24 +280,32 @@ int External::lookahead () {
   return elit;
 }
 
-CaDiCaL::CubesWithStatus External::generate_cubes (int depth, int min_depth = 0) {
+// Maps the internal literals of generated cubes back to external literals
+// before handing them to the user provided iterator.
+
+struct CubeExternalizer : public CubeIterator {
+  Internal * internal;
+  CubeIterator & it;
+  std::vector<int> ecube;
+  CubeExternalizer (Internal * i, CubeIterator & c) : internal (i), it (c) { }
+  bool cube (const std::vector<int> & icube) {
+    ecube.clear ();
+    MSG("Cube : ");
+    for (const auto & ilit : icube) {
+      const int elit = ilit ? internal->externalize (ilit) : 0;
+      MSG ("lookahead internal %d external %d", ilit, elit);
+      ecube.push_back (elit);
+    }
+    return it.cube (ecube);
+  }
+};
+
+int External::generate_cubes (int depth, int min_depth, CubeIterator & it) {
   reset_extended ();
   update_molten_literals ();
   reset_limits ();
-  auto cubes = internal->generate_cubes (depth, min_depth);
-  auto externalize = [this](int ilit) {
-    const int elit = ilit ? internal->externalize (ilit) : 0;
-    MSG ("lookahead internal %d external %d", ilit, elit);
-    return elit;
-  };
-  auto externalize_map = [this, externalize](std::vector<int> cube) {
-    (void) this;
-    MSG("Cube : ");
-    std::for_each(begin(cube), end(cube), externalize);
-  };
-  std::for_each(begin(cubes.cubes), end(cubes.cubes), externalize_map);
-
-  return cubes;
+  CubeExternalizer externalizer (internal, it);
+  return internal->generate_cubes (depth, min_depth, externalizer);
 }
 
 /*------------------------------------------------------------------------*/
@@ -540,4 +571,101 @@ void External::export_learned_large_clause (const vector<int> & clause, int glue
     LOG ("not exporting learned clause of size %zu", size);
 }
 
+/*------------------------------------------------------------------------*/
+
+// Buffering learned clauses for the batch learner only costs a limit check
+// and externalizing the literals on the conflict path.
+
+void External::buffer_learned_unit_clause (int ilit) {
+  assert (batch_learner);
+  if (batch_size < 1) return;
+  const int elit = internal->externalize (ilit);
+  assert (elit);
+  exported.push_back (0);
+  exported.push_back (elit);
+  exported.push_back (0);
+}
+
+void
+External::buffer_learned_large_clause (const vector<int> & clause, int glue) {
+  assert (batch_learner);
+  if (clause.size () > (size_t) batch_size) return;
+  if (glue > batch_glue) return;
+  const size_t start = exported.size ();
+  exported.push_back (glue);
+  for (auto ilit : clause) {
+    const int elit = internal->externalize (ilit);
+    assert (elit);
+    exported.push_back (elit);
+  }
+  if (duplicated_shared_clause (&exported[start + 1], clause.size ())) {
+    LOG ("not buffering duplicated clause of size %zu", clause.size ());
+    internal->stats.clauseimport.e_dup++;
+    exported.resize (start);
+    return;
+  }
+  LOG ("buffering learned clause of size %zu", clause.size ());
+  exported.push_back (0);
+}
+
+// Checks the duplicate filter with the given external literals of an
+// exported or imported clause and inserts the clause if it is new.
+
+bool External::duplicated_shared_clause (const int * lits, size_t size) {
+  const Options & opts = internal->opts;
+  if (!opts.sharedup) return false;
+  return shared.duplicated (lits, size, opts.sharedupsize,
+                            internal->stats.conflicts, opts.sharedupage);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Representatives of substituted variables are kept in terms of external
+// literals, since 'compact' removes substituted variables internally.  The
+// representative might have been substituted later again, thus the map is
+// followed until reaching a literal which is not substituted anymore.
+// Reactivating a variable in 'internalize' resets its representative.
+
+void External::substitute (int idx, int repr) {
+  assert (idx > 0);
+  const int eidx = internal->externalize (idx);
+  assert (eidx > 0);
+  if ((size_t) eidx >= reprs.size ()) reprs.resize (1 + (size_t) max_var);
+  reprs[eidx] = internal->externalize (repr);
+  LOG ("external %d substituted by %d", eidx, reprs[eidx]);
+}
+
+int External::representative (int elit) {
+  for (;;) {
+    const int eidx = abs (elit);
+    if (eidx >= (int) reprs.size ()) return elit;
+    const int repr = reprs[eidx];
+    if (!repr) return elit;
+    const int ilit = e2i[eidx];
+    if (ilit && !internal->flags (ilit).substituted ()) return elit;
+    elit = elit < 0 ? -repr : repr;
+  }
+}
+
+// A literal is inactive if its variable is eliminated, substituted or pure
+// or was removed by 'compact' while still occurring on the extension stack.
+
+bool External::inactive (int elit) {
+  const int eidx = abs (elit);
+  if (eidx > max_var) return false;
+  const int ilit = e2i[eidx];
+  if (!ilit) return marked (witness, eidx) || marked (witness, -eidx);
+  const Flags & f = internal->flags (ilit);
+  return f.eliminated () || f.substituted () || f.pure ();
+}
+
+void External::flush_learned_clauses () {
+  if (!batch_learner) return;
+  if (exported.empty ()) return;
+  LOG ("flushing %zu buffered learned clause literals", exported.size ());
+  const int * begin = exported.data ();
+  batch_learner->learn (begin, begin + exported.size ());
+  exported.clear ();
+}
+
 }
@@ -3,6 +3,7 @@
 
 /*------------------------------------------------------------------------*/
 
+#include "filter.hpp"   // Alphabetically after 'external.hpp'.
 #include "range.hpp"
 
 /*------------------------------------------------------------------------*/
@@ -42,7 +43,6 @@ using namespace std;
 
 struct Clause;
 struct Internal;
-struct CubesWithStatus;
 
 /*------------------------------------------------------------------------*/
 
@@ -74,6 +74,7 @@ struct External {
 
   vector<bool> witness;       // Literal witness on extension stack.
   vector<bool> tainted;       // Literal tainted in adding literals.
+  vector<int> reprs;          // Representatives of substituted variables.
 
   vector<unsigned> frozentab; // Reference counts for frozen variables.
 
@@ -91,6 +92,28 @@ struct External {
   void export_learned_unit_clause (int ilit);
   void export_learned_large_clause (const vector<int> &, int glue);
 
+  // If there is a batch learner learned clauses within the size and glue
+  // limits are buffered in 'exported' and flushed at restarts.
+
+  BatchLearner * batch_learner;
+  int batch_size, batch_glue;
+  vector<int> exported;
+
+  // Recently exported and imported clauses (see 'filter.hpp').
+
+  ClauseFilter shared;
+  bool duplicated_shared_clause (const int * lits, size_t size);
+
+  // Imported clauses over inactive variables (see 'import_reactivate').
+
+  void substitute (int idx, int repr);
+  int representative (int elit);
+  bool inactive (int elit);
+
+  void buffer_learned_unit_clause (int ilit);
+  void buffer_learned_large_clause (const vector<int> &, int glue);
+  void flush_learned_clauses ();
+
   //----------------------------------------------------------------------//
 
   signed char * solution;     // Given solution checking for debugging.
@@ -251,6 +274,7 @@ struct External {
   // Proxies to IPASIR functions.
 
   void add (int elit);
+  void add (const int * lits, size_t size);     // bulk 'add' for parser
   void assume (int elit);
   int solve (bool preprocess_only);
 
@@ -275,7 +299,7 @@ struct External {
   // Other important non IPASIR functions.
 
   int lookahead();
-  CaDiCaL::CubesWithStatus generate_cubes(int, int);
+  int generate_cubes (int depth, int min_depth, CubeIterator &);
 
   int fixed (int elit) const;   // Implemented in 'internal.hpp'.
 
@@ -300,6 +324,10 @@ struct External {
 
   void copy_flags (External & other) const;
 
+  // Deep copy for 'Solver::clone' (see 'Internal::clone' in 'clone.cpp').
+
+  void clone (External & dst) const;
+
   /*----------------------------------------------------------------------*/
 
   // Check solver behaves as expected during testing and debugging.
@@ -7,6 +7,7 @@
 extern "C" {
 #include <string.h>
 #include <errno.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -30,7 +31,8 @@ File::File (Internal *i, bool w, int c, FILE * f, const char * n)
   writing (w),
 #endif
   close_file (c), file (f),
-  _name (n), _lineno (1), _bytes (0)
+  _name (n), _lineno (1), _bytes (0),
+  map_begin (0), map_pos (0), map_end (0)
 {
   (void) i, (void) w;
   assert (f), assert (n);
@@ -237,7 +239,45 @@ READ_FILE:
     close_input = 1;
   }
 
-  return file ? new File (internal, false, close_input, file, path) : 0;
+  if (!file) return 0;
+  File * res = new File (internal, false, close_input, file, path);
+  if (close_input == 1) res->map ();
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Map a regular file opened for reading into memory.  If this fails for
+// any reason (empty file, special file, out of address space) we silently
+// keep reading through 'getc'.  Nothing has been read from 'file' yet.
+
+void File::map () {
+  assert (!writing);
+  assert (file);
+  assert (!map_begin);
+  assert (!_bytes);
+  struct stat buf;
+  const int fd = fileno (file);
+  if (fstat (fd, &buf) || !S_ISREG (buf.st_mode) || buf.st_size <= 0)
+    return;
+  const size_t bytes = buf.st_size;
+  void * p = mmap (0, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (p == MAP_FAILED) {
+    MSG ("memory mapping '%s' failed", name ());
+    return;
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise (p, bytes, MADV_SEQUENTIAL);
+#endif
+  map_begin = map_pos = (const char *) p;
+  map_end = map_begin + bytes;
+  MSG ("memory mapped %zd bytes of '%s'", bytes, name ());
+}
+
+void File::unmap () {
+  assert (map_begin);
+  munmap ((void *) map_begin, map_end - map_begin);
+  map_begin = map_pos = map_end = 0;
 }
 
 File * File::write (Internal * internal, const char * path) {
@@ -272,6 +312,8 @@ void File::close () {
     pclose (file);
   }
 
+  if (map_begin) unmap ();
+
   file = 0;     // mark as closed
 
 #ifndef QUIET
@@ -4,11 +4,18 @@
 #include <cstdio>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
 
 #ifndef NDEBUG
 #include <climits>
 #endif
 
+/*------------------------------------------------------------------------*/
+#if defined(__GNUC__) && defined(__SSE2__)
+#define SIMD_DIGITS
+#include <emmintrin.h>
+#endif
 /*------------------------------------------------------------------------*/
 #ifndef NUNLOCKED
 #define cadical_putc_unlocked putc_unlocked
@@ -24,7 +31,10 @@ namespace CaDiCaL {
 // Wraps a 'C' file 'FILE' with name and supports zipped reading and writing
 // through 'popen' using external helper tools.  Reading has line numbers.
 // Compression and decompression relies on external utilities, e.g., 'gzip',
-// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.
+// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.  Uncompressed
+// files opened by path for reading are memory mapped if possible, which
+// avoids the per character overhead of 'getc' and allows 'digits' to scan
+// numbers directly in the mapped buffer.
 
 struct Internal;
 
@@ -43,8 +53,15 @@ class File {
   uint64_t _lineno;
   uint64_t _bytes;
 
+  const char * map_begin;       // memory mapped file (if non-zero)
+  const char * map_pos;         // next character in mapped file
+  const char * map_end;
+
   File (Internal *, bool, int, FILE *, const char *);
 
+  void map ();
+  void unmap ();
+
   static FILE * open_file (Internal *,
                            const char * path, const char * mode);
   static FILE * read_file (Internal *, const char * path);
@@ -93,12 +110,58 @@ public:
 
   int get () {
     assert (!writing);
-    int res = cadical_getc_unlocked (file);
+    int res;
+    if (map_pos) res = map_pos < map_end ? (unsigned char) *map_pos++ : EOF;
+    else res = cadical_getc_unlocked (file);
     if (res == '\n') _lineno++;
     if (res != EOF) _bytes++;
     return res;
   }
 
+  // Fast path for parsing numbers in memory mapped files.  If at most nine
+  // decimal digits follow at the current position they are consumed and
+  // their value is stored in 'res' and the number of digits is returned.
+  // Otherwise, e.g., if the file is not mapped, close to its end or for
+  // more than nine digits, nothing is consumed and the result is negative
+  // (the caller then falls back to 'get').  The digits are classified with
+  // SSE2 for sixteen bytes at once and converted without branches.
+
+  int digits (unsigned & res) {
+    assert (!writing);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return -1;
+#endif
+    if (!map_pos || map_end - map_pos < 16) return -1;
+    unsigned n;
+#ifdef SIMD_DIGITS
+    const __m128i bytes = _mm_loadu_si128 ((const __m128i *) map_pos);
+    const __m128i digit = _mm_and_si128 (
+      _mm_cmpgt_epi8 (bytes, _mm_set1_epi8 ('0' - 1)),
+      _mm_cmplt_epi8 (bytes, _mm_set1_epi8 ('9' + 1)));
+    const unsigned mask = _mm_movemask_epi8 (digit);
+    n = __builtin_ctz (~mask);
+#else
+    for (n = 0; n < 16 && (unsigned) (map_pos[n] - '0') < 10; n++)
+      ;
+#endif
+    if (n > 9) return -1;
+    if (!n) { res = 0; return 0; }
+    const unsigned m = n < 8 ? n : 8;
+    uint64_t word;
+    memcpy (&word, map_pos, 8);
+    word -= UINT64_C (0x3030303030303030);
+    word <<= 8*(8 - m);                 // drop non-digits (leading zeros)
+    word = ((word & UINT64_C (0x0f0f0f0f0f0f0f0f)) * 2561) >> 8;
+    word = ((word & UINT64_C (0x00ff00ff00ff00ff)) * 6553601) >> 16;
+    word = ((word & UINT64_C (0x0000ffff0000ffff)) *
+             UINT64_C (42949672960001)) >> 32;
+    res = (unsigned) word;
+    if (n == 9) res = 10*res + (map_pos[8] - '0');
+    map_pos += n;
+    _bytes += n;
+    return n;
+  }
+
   bool put (char ch) {
     assert (writing);
     if (cadical_putc_unlocked (ch, file) == EOF) return false;
@@ -163,6 +226,21 @@ public:
     }
   }
 
+  // The not yet read part of a memory mapped file (empty if not mapped)
+  // can be parsed in parallel with the help of these functions.  After
+  // parsing it completely 'skip' moves to the end of the file and updates
+  // the line and byte counters.
+
+  const char * mapped_begin () const { return map_pos; }
+  const char * mapped_end () const { return map_end; }
+
+  void skip (uint64_t lines) {
+    assert (map_pos);
+    _lineno += lines;
+    _bytes += map_end - map_pos;
+    map_pos = map_end;
+  }
+
   const char * name () const { return _name; }
   uint64_t lineno () const { return _lineno; }
   uint64_t bytes () const { return _bytes; }
@@ -0,0 +1,62 @@
+#ifndef _filter_hpp_INCLUDED
+#define _filter_hpp_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Filter of recently exported and imported clauses, which avoids sharing
+// and importing the same clause several times (see 'sharedup').  It is a
+// direct mapped table of clause signatures, i.e., order independent 64-bit
+// hashes of the external literals, each stamped with the number of
+// conflicts at insertion.  Entries older than the given age are ignored
+// and colliding clauses just overwrite each other.  Hash collisions might
+// drop a new clause, which is fine since shared clauses are redundant.
+
+class ClauseFilter {
+
+  struct Entry {
+    uint64_t signature;
+    int64_t stamp;
+  };
+
+  std::vector<Entry> table;
+
+  static uint64_t hash (int lit) {
+    uint64_t res = (uint64_t) (int64_t) lit * 0x9e3779b97f4a7c15ul;
+    res ^= res >> 29;
+    res *= 0xbf58476d1ce4e5b9ul;
+    return res ^ (res >> 32);
+  }
+
+public:
+
+  // Returns true if the clause was seen within the last 'age' conflicts
+  // and otherwise (re)inserts it stamped with 'now'.  The table is
+  // allocated lazily with '2^log2size' entries.
+  //
+  bool duplicated (const int * lits, size_t size,
+                   unsigned log2size, int64_t now, int64_t age) {
+    uint64_t sum = size, xored = 0;
+    for (const int * p = lits; p != lits + size; p++) {
+      const uint64_t tmp = hash (*p);
+      sum += tmp;
+      xored ^= tmp;
+    }
+    uint64_t signature = sum ^ (xored * 0x94d049bb133111ebul);
+    if (!signature) signature = 1;
+    const size_t entries = (size_t) 1 << log2size;
+    if (table.size () != entries) table.assign (entries, Entry { 0, 0 });
+    Entry & entry = table[signature & (entries - 1)];
+    if (entry.signature == signature && now - entry.stamp <= age)
+      return true;
+    entry.signature = signature;
+    entry.stamp = now;
+    return false;
+  }
+};
+
+}
+
+#endif
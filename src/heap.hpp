@@ -173,6 +173,15 @@ public:
     pos.clear ();
   }
 
+  // Copy the elements of 'other' but keep our own 'less' (which usually
+  // refers to the owning solver and thus can not be copied).
+  //
+  void copy (const heap & other) {
+    array = other.array;
+    pos = other.pos;
+    check ();
+  }
+
   void erase () {
     erase_vector (array);
     erase_vector (pos);
@@ -1,4 +1,5 @@
 #include "internal.hpp"
+#include "propagate.hpp"
 
 namespace CaDiCaL {
 
@@ -57,73 +58,41 @@ inline void Internal::inst_assign (int lit) {
   trail.push_back (lit);
 }
 
+struct InstPropagation {
+
+  static const bool simd = false;
+  static const bool ignore = false;
+  static const bool ternary = true;
+
+  Internal * internal;
+
+  InstPropagation (Internal * i) : internal (i) { }
+
+  bool vectorize () const { return false; }
+
+  void assign (int lit, Clause *, int) { internal->inst_assign (lit); }
+
+  bool assign (int lit, Clause *) {
+    internal->inst_assign (lit);
+    return false;
+  }
+};
+
 bool Internal::inst_propagate () {      // Adapted from 'propagate'.
   START (propagate);
+  assert (!conflict);
+  InstPropagation policy (this);
   int64_t before = propagated;
-  bool ok = true;
-  while (ok && propagated != trail.size ()) {
+  while (!conflict && propagated != trail.size ()) {
     const int lit = -trail[propagated++];
     LOG ("instantiate propagating %d", -lit);
-    Watches & ws = watches (lit);
-    const const_watch_iterator eow = ws.end ();
-    const_watch_iterator i = ws.begin ();
-    watch_iterator j = ws.begin ();
-    while (i != eow) {
-      const Watch w = *j++ = *i++;
-      const signed char b = val (w.blit);
-      if (b > 0) continue;
-      if (w.binary ()) {
-        if (b < 0) { ok = false; LOG (w.clause, "conflict"); break; }
-        else inst_assign (w.blit);
-      } else {
-        literal_iterator lits = w.clause->begin ();
-        const int other = lits[0]^lits[1]^lit;
-        lits[0] = other, lits[1] = lit;
-        const signed char u = val (other);
-        if (u > 0) j[-1].blit = other;
-        else {
-          const int size = w.clause->size;
-          const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
-          literal_iterator k = middle;
-          signed char v = -1;
-          int r = 0;
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
-          if (v < 0) {
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
-          }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
-          if (v > 0) {
-            j[-1].blit = r;
-          } else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
-            lits[1] = r;
-            *k = lit;
-            watch_literal (r, lit, w.clause);
-            j--;
-          } else if (!u) {
-            assert (v < 0);
-            inst_assign (other);
-          } else {
-            assert (u < 0);
-            assert (v < 0);
-            LOG (w.clause, "conflict");
-            ok = false;
-            break;
-          }
-        }
-      }
-    }
-    if (j != i) {
-      while (i != eow)
-        *j++ = *i++;
-      ws.resize (j - ws.begin ());
-    }
+    propagate_binary_watches (policy, lit);
+    if (!conflict) propagate_watches (policy, lit);
+  }
+  const bool ok = !conflict;
+  if (conflict) {
+    LOG (conflict, "conflict");
+    conflict = 0;
   }
   int64_t delta = propagated - before;
   stats.propagations.instantiate += delta;
@@ -24,6 +24,8 @@ Internal::Internal ()
   vals (0),
   score_inc (1.0),
   scores (this),
+  loccs (this),
+  watchstore (this),
   conflict (0),
   ignore (0),
   propagated (0),
@@ -31,6 +33,7 @@ Internal::Internal ()
   best_assigned (0),
   target_assigned (0),
   no_conflict_until (0),
+  saved_replayed (0),
   proof (0),
   checker (0),
   tracer (0),
@@ -38,6 +41,7 @@ Internal::Internal ()
 #ifndef QUIET
   profiles (this),
   force_phase_messages (false),
+  tlb_misses_counter (-2),
 #endif
   arena (this),
   prefix ("c "),
@@ -56,7 +60,10 @@ Internal::~Internal () {
   if (proof) delete proof;
   if (tracer) delete tracer;
   if (checker) delete checker;
-  if (vals) { vals -= vsize; delete [] vals; }
+  if (vals) { vals -= vsize; free (vals); }
+#ifndef QUIET
+  close_tlb_misses_counter (tlb_misses_counter);
+#endif
 }
 
 /*------------------------------------------------------------------------*/
@@ -81,15 +88,17 @@ static signed char * ignore_clang_analyze_memory_leak_warning;
 
 void Internal::enlarge_vals (size_t new_vsize) {
   signed char * new_vals;
-  const size_t bytes = 2u * new_vsize;
-  new_vals = new signed char [ bytes ]; // g++-4.8 does not like ... { 0 };
+  const size_t bytes = 2u * new_vsize + sizeof (int); // see 'propagate'
+  if (opts.hugepages) new_vals = (signed char *) allocate_huge_pages (bytes);
+  else new_vals = (signed char *) malloc (bytes);
+  if (!new_vals) throw std::bad_alloc ();
   memset (new_vals, 0, bytes);
   ignore_clang_analyze_memory_leak_warning = new_vals;
   new_vals += new_vsize;
 
   if (vals) memcpy (new_vals - max_var, vals - max_var, 2u*max_var + 1u);
   vals -= vsize;
-  delete [] vals;
+  free (vals);
   vals = new_vals;
 }
 
@@ -112,6 +121,11 @@ static void enlarge_zero (vector<T> & v, size_t N) {
   enlarge_init (v, N, (const T &) 0);
 }
 
+template<class T>
+static void advise_huge_pages (vector<T> & v) {
+  advise_huge_pages (v.data (), v.capacity () * sizeof (T));
+}
+
 /*------------------------------------------------------------------------*/
 
 void Internal::enlarge (int new_max_var) {
@@ -121,7 +135,13 @@ void Internal::enlarge (int new_max_var) {
   LOG ("enlarge internal size from %zd to new size %zd", vsize, new_vsize);
   // Ordered in the size of allocated memory (larger block first).
   enlarge_only (wtab, 2*new_vsize);
+  enlarge_only (bwtab, 2*new_vsize);
   enlarge_only (vtab, new_vsize);
+  // Watches themselves are kept in huge page chunks of the watch store
+  // (see 'WatchStore::add_chunk') and thus 'wtab' and 'bwtab' only hold
+  // small list headers, which are not worth advising.
+  //
+  if (opts.hugepages) advise_huge_pages (vtab);
   enlarge_zero (parents, new_vsize);
   enlarge_only (links, new_vsize);
   enlarge_zero (btab, new_vsize);
@@ -216,141 +236,295 @@ int Internal::cdcl_loop_with_inprocessing () {
   if (stable) { STOP (stable);   report (']'); }
   else        { STOP (unstable); report ('}'); }
 
+  external->flush_learned_clauses ();
+
   STOP (search);
 
   return res;
 }
 
 bool Internal::importing () {
-  return level == 0 && external->learnSource != 0 
+  return external->learnSource != 0
       && watching() && external->learnSource->hasNextClause ();
 }
 
-void Internal::import_redundant_clauses (int& res) {
-  if (external->learnSource == 0) return;
-  if (res != 0) return;
+// Clauses are imported at any decision level.  Then the two literals to
+// be watched are moved to the front, preferring true over unassigned over
+// false literals, true literals on lower and false literals on higher
+// assignment levels.  Literals fixed at the root level are removed before.
 
-  // Import external clauses.
-  while (external->learnSource->hasNextClause ()) {
+inline bool Internal::import_better (int a, int b) {
+  const signed char u = val (a), v = val (b);
+  if (u != v) return u > v;
+  if (u > 0) return var (a).level < var (b).level;
+  if (u < 0) return var (a).level > var (b).level;
+  return false;
+}
 
-    // Fetch pointer to 1st literal and size of the clause (plus glue)
-    auto cls = external->learnSource->getNextClause ();
-    size_t size = cls.size ();
-    //printf("Import clause of size %lu\n", size);
-    assert (size > 0);
-    int unitLit = size == 1 ? cls[0] : 0;
-    assert (clause.empty ());
+void Internal::import_watch_order () {
+  assert (clause.size () >= 2);
+  for (size_t i = 0; i < 2; i++) {
+    size_t best = i;
+    for (size_t j = i + 1; j < clause.size (); j++)
+      if (import_better (clause[j], clause[best])) best = j;
+    swap (clause[i], clause[best]);
+  }
+}
 
-    if (unitLit == 0) {
-      // Learn non-unit clause
+// If the second watch is false the imported clause might be unit or even
+// falsified, or satisfied only on a higher level than the second watch
+// is falsified, which would break the watch invariant after backtracking.
+// In all these cases we backtrack to the level of the second watch and
+// assign the first one, unless both watches are falsified on the same
+// level, where backtracking one more level unassigns both.
+
+void Internal::import_assign (Clause * c) {
+  const int lit = c->literals[0], other = c->literals[1];
+  const signed char u = val (lit), v = val (other);
+  if (v >= 0) return;
+  const int other_level = var (other).level;
+  assert (other_level > 0);
+  if (u && var (lit).level == other_level) {
+    if (u > 0) return;
+    LOG (c, "imported conflicting clause");
+    backtrack (other_level - 1);
+    return;
+  }
+  if (u > 0 && var (lit).level < other_level) return;
+  LOG (c, "imported clause forcing %d on level %d", lit, other_level);
+  backtrack (other_level);
+  assert (!val (lit));
+  search_assign_driving (lit, c);
+}
 
-      // Glue int at the front
-      int glue = cls[0];
-      assert (glue > 0);
+// Import a single clause given by its glue and literals (the glue is
+// ignored for units).  Substituted literals are replaced by their
+// representatives if 'sharerepr' is set.  Clauses over inactive (see
+// 'import_reactivate') or witness literals are rejected and clauses
+// satisfied at the root level too.  Since mapping literals might produce
+// duplicated and complementary literals the imported literals are marked.
 
-      // Analyze clause literals
-      bool addClause = true;
-      bool hasFixedLits = false;
-      for (size_t i = 1; i < size; i++) {
+void Internal::import_redundant_clause (int glue,
+                                        const int * lits, size_t size) {
+  assert (size > 0);
+  assert (clause.empty ());
+  int unitLit = size == 1 ? lits[0] : 0;
 
-        int elit = cls[i];
-        assert (elit != 0);
+  if (unitLit == 0) {
+    // Learn non-unit clause
 
-        if (external->marked (external->witness, elit)) {
-          // Literal marked as witness: Cannot import
-          internal->stats.clauseimport.r_wit++;
-          addClause = false; break;
-        }
+    assert (glue > 0);
 
-        int ilit = external->internalize(elit);
+    // Units are caught below when fixed, thus only check larger clauses.
+    if (external->duplicated_shared_clause (lits, size)) {
+      internal->stats.clauseimport.r_dup++;
+      internal->stats.clauseimport.discarded++;
+      return;
+    }
 
-        auto& f = flags (ilit);
-        if (f.eliminated () || f.substituted ()) {
-          // Literal has been eliminated: do not add this clause.
-          internal->stats.clauseimport.r_el++;
-          addClause = false; break;
-        } else if (f.fixed ()) {
-          // Literal is fixed
-          if (val (ilit) == 1) {
-            // TRUE: Clause can be omitted.
-            internal->stats.clauseimport.r_fx++;
-            addClause = false; break;
-          } // else: FALSE - literal can be omitted.
-          hasFixedLits = true;
-        } else {
-          // Can treat literal normally.
-          clause.push_back (ilit);
-          unitLit = elit;
-        }
+    // Analyze clause literals
+    bool addClause = true;
+    bool hasFixedLits = false;
+    for (size_t i = 0; i < size; i++) {
+
+      int elit = lits[i];
+      assert (elit != 0);
+
+      if (opts.sharerepr) elit = external->representative (elit);
+
+      if (external->inactive (elit)) {
+        // Literal has been eliminated: do not add this clause.
+        internal->stats.clauseimport.r_el++;
+        addClause = false; break;
       }
 
-      if (!addClause) {
-        //printf("Discard clause\n");
-        internal->stats.clauseimport.discarded++;
-        clause.clear ();
-        continue;
+      if (external->marked (external->witness, elit)) {
+        // Literal marked as witness: Cannot import
+        internal->stats.clauseimport.r_wit++;
+        addClause = false; break;
       }
 
-      // Handle clause of size >= 2 being learnt
-      // (unit clauses are handled below)
-      if (clause.size () >= 2) {
-        //printf("Learn non-unit clause\n");
-        external->check_learned_clause ();
-        Clause * res = new_clause (true, glue);
-        if (proof) proof->add_derived_clause (res);
-        assert (watching ());
-        watch_clause (res);
-        unitLit = 0;
-        internal->stats.clauseimport.imported++;
-      } else if (clause.size() == 1) {
-        unitLit = internal->externalize (clause[0]);
+      int ilit = external->internalize(elit);
+
+      auto& f = flags (ilit);
+      if (f.fixed ()) {
+        // Literal is fixed
+        if (val (ilit) == 1) {
+          // TRUE: Clause can be omitted.
+          internal->stats.clauseimport.r_fx++;
+          addClause = false; break;
+        } // else: FALSE - literal can be omitted.
+        hasFixedLits = true;
+      } else if (marked (ilit) > 0) {
+        // Duplicated after mapping: literal can be omitted.
+      } else if (marked (ilit) < 0) {
+        // Tautological after mapping: Clause can be omitted.
+        addClause = false; break;
       } else {
-        if (hasFixedLits) internal->stats.clauseimport.r_fx++;
-        internal->stats.clauseimport.discarded++;
+        // Can treat literal normally.
+        mark (ilit);
+        clause.push_back (ilit);
+        unitLit = elit;
       }
+    }
+
+    for (const auto & ilit : clause)
+      unmark (ilit);
 
+    if (!addClause) {
+      internal->stats.clauseimport.discarded++;
       clause.clear ();
+      return;
     }
 
-    // Try to learn unit clause
-    if (unitLit != 0) {
-      if (external->marked (external->witness, unitLit)) {
-        // Do not learn unit clause if marked as witness
-        internal->stats.clauseimport.r_wit++;
-        internal->stats.clauseimport.discarded++;
-        continue;
-      }
-      int ilit = external->internalize (unitLit);
-      auto& f = flags(ilit);
-      if (f.eliminated () || f.substituted ()) {
-        // Do not import eliminated or substituted literal
-        internal->stats.clauseimport.r_el++;
-        internal->stats.clauseimport.discarded++;
-        continue;
-      }
-      // Do not import units which are already fixed
-      if (f.status == Flags::FIXED) {
-        internal->stats.clauseimport.r_fx++;
-        internal->stats.clauseimport.discarded++;
-        continue;
-      }
-      // Actually add the unit clause
-      assign_original_unit (ilit);
+    // Handle clause of size >= 2 being learnt
+    // (unit clauses are handled below)
+    if (clause.size () >= 2) {
+      external->check_learned_clause ();
+      if (level) import_watch_order ();
+      Clause * res = new_clause (true, glue);
+      if (proof) proof->add_derived_clause (res);
+      assert (watching ());
+      watch_clause (res);
+      if (level) import_assign (res);
+      unitLit = 0;
       internal->stats.clauseimport.imported++;
+    } else if (clause.size() == 1) {
+      unitLit = internal->externalize (clause[0]);
+    } else {
+      if (hasFixedLits) internal->stats.clauseimport.r_fx++;
+      internal->stats.clauseimport.discarded++;
     }
 
-    // Stop importing if SAT or UNSAT was found
-    if (unsat) {
-      res = 20;
+    clause.clear ();
+  } else if (opts.sharerepr) unitLit = external->representative (unitLit);
+
+  // Try to learn unit clause
+  if (unitLit != 0) {
+    if (external->inactive (unitLit)) {
+      // Do not import eliminated or substituted literal
+      internal->stats.clauseimport.r_el++;
+      internal->stats.clauseimport.discarded++;
       return;
     }
-    if (satisfied ()) {
-      res = 10;
+    if (external->marked (external->witness, unitLit)) {
+      // Do not learn unit clause if marked as witness
+      internal->stats.clauseimport.r_wit++;
+      internal->stats.clauseimport.discarded++;
+      return;
+    }
+    int ilit = external->internalize (unitLit);
+    auto& f = flags(ilit);
+    // Do not import units which are already fixed
+    if (f.status == Flags::FIXED) {
+      internal->stats.clauseimport.r_fx++;
+      internal->stats.clauseimport.discarded++;
       return;
     }
+    // Actually add the unit clause
+    if (level) backtrack ();
+    assign_original_unit (ilit);
+    internal->stats.clauseimport.imported++;
   }
 }
 
+// Imported clauses might contain literals which are inactive here, i.e.,
+// their variables are eliminated, substituted or pure, or even removed by
+// 'compact'.  If 'sharerepr' is set substituted literals are mapped to
+// their representatives instead.  Otherwise these clauses are rejected,
+// unless the variables are reactivated by restoring their clauses from
+// the extension stack as in incremental solving (see 'restore.cpp').  This
+// requires to backtrack to the root level and a pass over the extension
+// stack.  Thus it is decided per batch and only if the batch does not
+// contain more than 'sharereactivate' such variables.
+
+void Internal::import_reactivate (const int * begin, const int * end) {
+  if (!opts.sharereactivate) return;
+  vector<int> candidates;
+  const int * p = begin;
+  while (p != end) {
+    p++;                                        // Skip glue.
+    int elit;
+    while ((elit = *p++)) {
+      if (opts.sharerepr) elit = external->representative (elit);
+      if (external->inactive (elit)) candidates.push_back (abs (elit));
+    }
+  }
+  if (candidates.empty ()) return;
+  sort (candidates.begin (), candidates.end ());
+  const auto last = unique (candidates.begin (), candidates.end ());
+  candidates.resize (last - candidates.begin ());
+  if (candidates.size () > (size_t) opts.sharereactivate) {
+    LOG ("not reactivating %zd variables for import", candidates.size ());
+    return;
+  }
+  LOG ("reactivating %zd variables for import", candidates.size ());
+  if (level) backtrack ();
+  for (const auto & eidx : candidates) {
+    external->internalize (eidx);               // Both literals need to be
+    external->internalize (-eidx);              // tainted to be restored.
+  }
+  stats.clauseimport.reactivated += candidates.size ();
+  restore_clauses ();
+}
+
+// Import a batch of clauses, each given as glue followed by its literals
+// and terminated by zero.
+
+void Internal::import_batch (const int * begin, const int * end, int & res) {
+  import_reactivate (begin, end);
+  if (import_finished (res)) return;
+  const int * p = begin;
+  while (p != end) {
+    const int glue = *p++;
+    const int * lits = p;
+    while (*p) p++;
+    import_redundant_clause (glue, lits, p++ - lits);
+    if (import_finished (res)) return;
+  }
+}
+
+// Stop importing if SAT or UNSAT was found.
+
+inline bool Internal::import_finished (int & res) {
+  if (unsat) res = 20;
+  else if (satisfied ()) res = 10;
+  return res;
+}
+
+void Internal::import_redundant_clauses (int& res) {
+  if (external->learnSource == 0) return;
+  if (res != 0) return;
+
+  // First import batches of clauses if the source provides them.  Each
+  // batch is a flat buffer of clauses, each given as glue followed by its
+  // literals and terminated by zero, and is imported in place.
+  //
+  const int * begin, * end;
+  while (external->learnSource->getNextClauses (begin, end)) {
+    import_batch (begin, end, res);
+    if (res) return;
+  }
+
+  // Then collect single clauses, given as literals of units and otherwise
+  // as glue followed by the literals of the clause, into one batch.
+  //
+  vector<int> & batch = imported;
+  assert (batch.empty ());
+  while (external->learnSource->hasNextClause ()) {
+    const auto & cls = external->learnSource->getNextClause ();
+    assert (!cls.empty ());
+    if (cls.size () == 1) batch.push_back (0);
+    batch.insert (batch.end (), cls.begin (), cls.end ());
+    batch.push_back (0);
+  }
+  if (!batch.empty ()) {
+    const int * data = batch.data ();
+    import_batch (data, data + batch.size (), res);
+  }
+  batch.clear ();
+}
+
 /*------------------------------------------------------------------------*/
 
 // Most of the limits are only initialized in the first 'solve' call and
@@ -712,11 +886,19 @@ int Internal::solve (bool preprocess_only) {
   if (preprocess_only) LOG ("internal solving in preprocessing only mode");
   else LOG ("internal solving in full mode");
   init_report_limits ();
+#ifndef QUIET
+  // The counter only counts the calling thread, thus it is opened lazily
+  // here (portfolio workers solve in their own thread) and only if
+  // resources are going to be printed (by default only in 'cadical').
+  if (tlb_misses_counter == -2 && opts.tlbmisses && !opts.quiet)
+    tlb_misses_counter = open_tlb_misses_counter ();
+#endif
   int res = already_solved ();
   if (!res) res = restore_clauses ();
   if (!res) {
     init_preprocessing_limits ();
     if (!preprocess_only) init_search_limits ();
+    check_memory_limit ();
   }
   if (!res) res = preprocess ();
   if (!preprocess_only) {
@@ -797,7 +979,11 @@ int Internal::lookahead () {
   int tmp = already_solved ();
   if (!tmp) tmp = restore_clauses ();
   int res = 0;
-  if (!tmp) res = lookahead_probing ();
+  if (!tmp) {
+    init_loccs ();
+    res = opts.march ? lookahead_march () : lookahead_probing ();
+    reset_loccs ();
+  }
   if (res == INT_MIN) res = 0;
   reset_solving ();
   report_solving (tmp);
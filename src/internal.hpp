@@ -54,6 +54,7 @@ extern "C" {
 #include "ema.hpp"
 #include "external.hpp"
 #include "file.hpp"
+#include "filter.hpp"
 #include "flags.hpp"
 #include "format.hpp"
 #include "heap.hpp"
@@ -62,10 +63,12 @@ extern "C" {
 #include "level.hpp"
 #include "limit.hpp"
 #include "logging.hpp"
+#include "lookahead.hpp"
 #include "message.hpp"
 #include "observer.hpp"
 #include "occs.hpp"
 #include "options.hpp"
+#include "parallel.hpp"
 #include "parse.hpp"
 #include "phases.hpp"
 #include "profile.hpp"
@@ -76,6 +79,7 @@ extern "C" {
 #include "range.hpp"
 #include "reluctant.hpp"
 #include "resources.hpp"
+#include "saved.hpp"
 #include "score.hpp"
 #include "stats.hpp"
 #include "terminal.hpp"
@@ -97,11 +101,6 @@ struct Coveror;
 struct External;
 struct Walker;
 
-struct CubesWithStatus {
-  int status;
-  std::vector<std::vector<int>> cubes;
-};
-
 /*------------------------------------------------------------------------*/
 
 struct Internal {
@@ -170,8 +169,12 @@ struct Internal {
   vector<Occs> otab;            // table of occurrences for all literals
   vector<int> ptab;             // table for caching probing attempts
   vector<int64_t> ntab;         // number of one-sided occurrences table
+  vector<int64_t> ltab;         // lookahead irredundant occurrences
+  LoccSchedule loccs;           // most occurring literal during lookahead
   vector<Bins> big;             // binary implication graph
   vector<Watches> wtab;         // table of watches for all literals
+  vector<Watches> bwtab;        // table of binary watches for all literals
+  WatchStore watchstore;        // pool holding all watch lists
   Clause * conflict;            // set in 'propagation', reset in 'analyze'
   Clause * ignore;              // ignored during 'vivify_propagate'
   size_t propagated;            // next trail position to propagate
@@ -180,6 +183,9 @@ struct Internal {
   size_t target_assigned;       // maximum assigned without conflict
   size_t no_conflict_until;     // largest trail prefix without conflict
   vector<int> trail;            // currently assigned literals
+  vector<Saved> saved_trail;    // unassigned during last backtrack
+  size_t saved_replayed;        // next saved literal to be replayed
+  vector<int> imported;         // batch of single imported clauses
   vector<int> clause;           // simplified in parsing & learning
   vector<int> assumptions;      // assumed literals
   vector<int> original;         // original added literals
@@ -204,6 +210,8 @@ struct Internal {
 #ifndef QUIET
   Profiles profiles;            // time profiles for various functions
   bool force_phase_messages;    // force 'phase (...)' messages
+  int tlb_misses_counter;       // hardware counter if non-negative
+                                // (-2 if not opened yet)
 #endif
   Arena arena;                  // memory arena for moving garbage collector
   Format error_message;         // provide persistent error message
@@ -327,8 +335,11 @@ struct Internal {
   Bins & bins (int lit)       { return big[vlit (lit)]; }
   Occs & occs (int lit)       { return otab[vlit (lit)]; }
   int64_t & noccs (int lit)   { return ntab[vlit (lit)]; }
+  int64_t & loccs_count (int lit) { return ltab[vlit (lit)]; }
   Watches & watches (int lit) { return wtab[vlit (lit)]; }
 
+  Watches & binary_watches (int lit) { return bwtab[vlit (lit)]; }
+
   // Variable bumping through exponential VSIDS (EVSIDS) as in MiniSAT.
   //
   bool use_scores () const { return opts.score && stable; }
@@ -432,16 +443,62 @@ struct Internal {
   void unmark_clause ();        // unmark 'this->clause'
   void unmark (Clause *);
 
+  // Generate a watch and get the clause of a watch.  With '-DWATCH32' the
+  // clause is referenced by a 32-bit offset into the arena (see
+  // 'watch.hpp').  Otherwise these are just wrappers.
+  //
+  Watch make_watch (int lit, int blit, Clause * c) const {
+    assert (lit != blit);
+#ifdef WATCH32
+    assert (c->size > 1);
+    (void) lit;
+    const unsigned ref = arena.reference (c);
+    assert (ref < (1u << 31));
+    return Watch (blit, (ref << 1) | (c->size == 2));
+#else
+    int third;
+    if (c->size == 2) third = 0;
+    else if (c->size == 3) {
+      const int * l = c->literals;
+      third = l[0] ^ l[1] ^ l[2] ^ lit ^ blit;
+      assert (third == l[0] || third == l[1] || third == l[2]);
+    } else third = INT_MIN;
+    return Watch (blit, c, third);
+#endif
+  }
+
+  Clause * watched_clause (const Watch & w) const {
+#ifdef WATCH32
+    return (Clause *) arena.dereference (w.ref >> 1);
+#else
+    return w.clause;
+#endif
+  }
+
   // Watch literal 'lit' in clause with blocking literal 'blit'.
   // Inlined here, since it occurs in the tight inner loop of 'propagate'.
+  // Binary clauses are kept in their own watch lists (see 'watch.hpp').
   //
   inline void watch_literal (int lit, int blit, Clause * c) {
     assert (lit != blit);
-    Watches & ws = watches (lit);
-    ws.push_back (Watch (blit, c));
+    Watches & ws = c->size == 2 ? binary_watches (lit) : watches (lit);
+    watchstore.push_back (ws, make_watch (lit, blit, c));
     LOG (c, "watch %d blit %d in", lit, blit);
   }
 
+  // Remove the (unique) watch of a clause from a watch list.
+  //
+  void remove_watch (Watches & ws, Clause * c) {
+    const auto end = ws.end ();
+    auto i = ws.begin ();
+    for (auto j = i; j != end; j++) {
+      const Watch & w = *i++ = *j;
+      if (watched_clause (w) == c) i--;
+    }
+    assert (i + 1 == end);
+    ws.resize (i - ws.begin ());
+  }
+
   // Add two watches to a clause.  This is used initially during allocation
   // of a clause and during connecting back all watches after preprocessing.
   //
@@ -455,8 +512,13 @@ struct Internal {
   inline void unwatch_clause (Clause * c) {
     const int l0 = c->literals[0];
     const int l1 = c->literals[1];
-    remove_watch (watches (l0), c);
-    remove_watch (watches (l1), c);
+    if (c->size == 2) {
+      remove_watch (binary_watches (l0), c);
+      remove_watch (binary_watches (l1), c);
+    } else {
+      remove_watch (watches (l0), c);
+      remove_watch (watches (l1), c);
+    }
   }
 
   // Update queue to point to last potentially still unassigned variable.
@@ -521,6 +583,10 @@ struct Internal {
   void search_assign_driving (int lit, Clause * reason);
   void search_assume_decision (int decision);
   void assign_unit (int lit);
+  template<class P> void propagate_binary_watches (P &, int lit);
+  template<class P> void propagate_watches (P &, int lit);
+  bool search_rewatch (int lit, Clause *);
+  template<class P> void search_propagate (P &);
   bool propagate ();
 
   // Undo and restart in 'backtrack.cpp'.
@@ -528,6 +594,9 @@ struct Internal {
   void unassign (int lit);
   void update_target_and_best ();
   void backtrack (int target_level = 0);
+  bool saving_trail () const;
+  void clear_saved_trail ();
+  void replay_saved_trail ();
 
   // Minimized learned clauses in 'minimize.cpp'.
   //
@@ -628,17 +697,32 @@ struct Internal {
   void remove_falsified_literals (Clause *);
   void mark_satisfied_clauses_as_garbage ();
   void copy_clause (Clause *);
-  void flush_watches (int lit, Watches &);
+  void flush_watches (int lit);
   size_t flush_occs (int lit);
   void flush_all_occs_and_watches ();
   void update_reason_references ();
   void copy_non_garbage_clauses ();
+#ifndef WATCH32
+  bool young_clause (Clause *);
+  bool minor_collection ();
+  void copy_young_clauses ();
+#endif
   void delete_garbage_clauses ();
   void check_clause_stats ();
   void check_var_stats ();
   bool arenaing ();
   void garbage_collection ();
 
+  // Deep copy of the solver state for 'Solver::clone' in 'clone.cpp'.
+  //
+  void clone (Internal & dst) const;
+
+  // Estimating memory usage and enforcing the memory limit.
+  //
+  size_t memory_usage ();
+  int memory_limit () const;
+  void check_memory_limit ();
+
   // Set-up occurrence list counters and containers.
   //
   void init_occs ();
@@ -652,9 +736,9 @@ struct Internal {
   //
   void init_watches ();
   void connect_watches (bool irredundant_only = false);
-  void sort_watches ();
   void clear_watches ();
   void reset_watches ();
+  void defrag_watches ();
 
   // Regular forward subsumption checking in 'subsume.cpp'.
   //
@@ -901,6 +985,7 @@ struct Internal {
 
     // ProbSAT/WalkSAT implementation called initially or from 'rephase'.
     //
+    void walk_watch_literal(int lit, int blit, Clause *);
     void walk_save_minimum(Walker &);
     Clause *walk_pick_clause(Walker &);
     unsigned walk_break_value(int lit);
@@ -936,6 +1021,13 @@ struct Internal {
 
     // Import learnt clauses from an external source.
     bool importing ();
+    bool import_better (int, int);
+    void import_watch_order ();
+    void import_assign (Clause *);
+    void import_redundant_clause (int glue, const int * lits, size_t size);
+    void import_reactivate (const int * begin, const int * end);
+    void import_batch (const int * begin, const int * end, int & res);
+    bool import_finished (int & res);
     void import_redundant_clauses (int& res);
 
     // Forcing decision variables to a certain phase.
@@ -978,6 +1070,7 @@ struct Internal {
     void limit_conflicts(int);     // Force conflict limit.
     void limit_preprocessing(int); // Enable 'n' preprocessing rounds.
     void limit_local_search(int);  // Enable 'n' local search rounds.
+    void limit_memory(int);        // Memory limit in MB.
 
     // External versions can access limits by 'name'.
     //
@@ -1024,14 +1117,29 @@ struct Internal {
 
     //
     int lookahead();
-    CubesWithStatus generate_cubes(int, int);
+    int generate_cubes(int depth, int min_depth, CubeIterator &);
     int most_occurring_literal();
     int lookahead_probing();
     int lookahead_next_probe();
     void lookahead_flush_probes();
     void lookahead_generate_probes();
-    std::vector<int> lookahead_populate_locc();
-    int lookahead_locc(const std::vector<int> &);
+    void init_loccs();
+    void reset_loccs();
+    void inc_loccs(Clause *);
+    void dec_loccs(Clause *);
+    void dec_locc(int lit);
+    bool counting_loccs() const { return !ltab.empty(); }
+    void lookahead_assign(int lit);
+    void lookahead_assign_decision(int lit);
+    bool lookahead_propagate();
+    double lookahead_reduced(size_t begin, int base);
+    void march_select(March &);
+    void march_forest(March &);
+    bool march_double(March &);
+    void march_evaluate(March &, int idx, double diff);
+    bool march_units(March &);
+    int march_decide(March &);
+    int lookahead_march();
 
     bool terminating_asked();
 
@@ -1246,6 +1354,16 @@ inline bool score_smaller::operator () (unsigned a, unsigned b) {
   return a > b;
 }
 
+// Same for 'locc_smaller' and 'Internal::ltab'.
+
+inline bool locc_smaller::operator () (unsigned a, unsigned b) {
+  const int64_t s = internal->ltab[a];
+  const int64_t t = internal->ltab[b];
+  if (s < t) return true;
+  if (s > t) return false;
+  return (a ^ 1) > (b ^ 1);
+}
+
 /*------------------------------------------------------------------------*/
 
 // Implemented here for keeping it all inline (requires Internal::fixed).
@@ -1280,6 +1398,14 @@ inline bool Internal::terminated_asynchronously (int factor)
     return true;
   }
 
+  // Exceeding the memory limit (see 'memory.cpp') stops preprocessing,
+  // inprocessing and search in the same way.
+  //
+  if (lim.memory.exceeded) {
+    LOG ("memory limit %d MB exceeded", memory_limit ());
+    return true;
+  }
+
   // This is only for testing and debugging asynchronous termination calls.
   // In production code this could be removed but then should not be costly
   // and keeping it will allow to test correctness of asynchronous
@@ -1341,6 +1467,11 @@ inline bool Internal::search_limits_hit ()
     return true;
   }
 
+  if (lim.memory.exceeded) {
+    LOG ("memory limit %d MB exceeded", memory_limit ());
+    return true;
+  }
+
   return false;
 }
 
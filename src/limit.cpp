@@ -89,12 +89,23 @@ void Internal::limit_local_search (int l) {
   }
 }
 
+void Internal::limit_memory (int l) {
+  if (l <= 0) {
+    LOG ("reset memory limit to 'memorylimit=%d'", opts.memorylimit);
+    inc.memory = 0;
+  } else {
+    inc.memory = l;
+    LOG ("new memory limit of %d MB", l);
+  }
+}
+
 bool Internal::is_valid_limit (const char * name) {
   if (!strcmp (name, "terminate")) return true;
   if (!strcmp (name, "conflicts")) return true;
   if (!strcmp (name, "decisions")) return true;
   if (!strcmp (name, "preprocessing")) return true;
   if (!strcmp (name, "localsearch")) return true;
+  if (!strcmp (name, "memory")) return true;
   return false;
 }
 
@@ -105,6 +116,7 @@ bool Internal::limit (const char * name, int l) {
   else if (!strcmp (name, "decisions")) limit_decisions (l);
   else if (!strcmp (name, "preprocessing")) limit_preprocessing (l);
   else if (!strcmp (name, "localsearch")) limit_local_search (l);
+  else if (!strcmp (name, "memory")) limit_memory (l);
   else res = false;
   return res;
 }
@@ -116,6 +128,8 @@ void Internal::reset_limits () {
   limit_decisions (-1);
   limit_preprocessing (0);
   limit_local_search (0);
+  limit_memory (0);
+  lim.memory.exceeded = false;
 }
 
 }
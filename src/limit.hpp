@@ -40,6 +40,11 @@ struct Limit {
     int forced;            // forced termination for testing
   } terminate;
 
+  struct {
+    bool pressure;         // close to memory limit (see 'memory.cpp')
+    bool exceeded;         // above limit thus stop search
+  } memory;
+
   Limit ();
 };
 
@@ -60,6 +65,7 @@ struct Inc {
   int64_t decisions;       // next decision limit if non-negative
   int64_t preprocessing;   // next preprocessing limit if non-negative
   int64_t localsearch;     // next local search limit if non-negative
+  int64_t memory;          // next memory limit in MB if positive
   Inc ();
 };
 
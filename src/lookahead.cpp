@@ -1,82 +1,113 @@
 #include "internal.hpp"
+#include "propagate.hpp"
 
 namespace CaDiCaL {
 
-struct literal_occ {
-  int lit;
-  int count;
-  bool operator<(const literal_occ &locc) const {
-    return (count > locc.count) || (count == locc.count && lit < locc.lit);
-
-  }
-  literal_occ operator++() {
-    ++count;
-    return *this;
-
+// The occurrences of literals in irredundant clauses are counted once at
+// the start of 'lookahead' and 'generate_cubes' and from then on updated
+// incrementally when clauses are added ('new_clause'), shrunken (during
+// 'decompose', strengthening and garbage collection) and removed or found
+// satisfied ('mark_garbage').  This avoids rescanning all clauses for each
+// cube.  The literals are kept in the heap 'loccs' ordered by these counts.
+
+// For march lookahead ('opts.march') the same hooks also maintain the
+// occurrence lists of irredundant clauses with more than two literals used
+// in 'lookahead_reduced'.  Garbage clauses are only skipped there and are
+// flushed from these lists during garbage collection ('flush_occs'), thus
+// only clauses shrunken in place by 'decompose' are removed eagerly.
+
+void Internal::init_loccs () {
+  assert (!counting_loccs ());
+  assert (loccs.empty ());
+  assert (!occurring ());
+  ltab.resize (2 + 2*(size_t) max_var, 0);
+  if (opts.march) init_occs ();
+  for (const auto & c : clauses) {
+    if (c->redundant || c->garbage) continue;
+    for (const auto & lit : *c)
+      loccs_count (lit)++;
+    if (opts.march && c->size > 2)
+      for (const auto & lit : *c)
+        occs (lit).push_back (c);
   }
+  for (auto idx : vars)
+    for (int sign = -1; sign <= 1; sign += 2) {
+      const int lit = sign * idx;
+      if (active (lit)) loccs.push_back (vlit (lit));
+    }
+}
 
-};
-
-std::vector<int> Internal::lookahead_populate_locc() {
-  std::vector<literal_occ> loccs((std::size_t)max_var+1);
-  for (std::size_t lit = 0; lit < loccs.size(); ++lit) {
-    loccs[lit].lit = lit;
-  }
-  for (const auto &c : clauses)
-    if (!c->redundant)
-      for (const auto &lit : *c)
-        if (active(lit))
-          ++loccs[std::abs(lit)];
-  std::sort(begin(loccs), end(loccs));
-  std::vector<int> locc_map;
-  locc_map.reserve(max_var);
-  for (const auto &locc : loccs)
-    locc_map.push_back(locc.lit);
-  return locc_map;
+void Internal::reset_loccs () {
+  assert (counting_loccs ());
+  erase_vector (ltab);
+  loccs.erase ();
+  if (occurring ()) reset_occs ();
+}
 
+void Internal::dec_locc (int lit) {
+  assert (counting_loccs ());
+  int64_t & count = loccs_count (lit);
+  assert (count > 0);
+  count--;
+  const unsigned ulit = vlit (lit);
+  if (loccs.contains (ulit)) loccs.update (ulit);
 }
 
-int Internal::lookahead_locc(const std::vector<int> &loccs) {
-  for (auto lit : loccs)
-    if (active(abs(lit)) && !assumed(lit) && !assumed(-lit) && !val(lit))
-      return lit;
-  return 0;
+void Internal::inc_loccs (Clause * c) {
+  assert (!c->redundant);
+  for (const auto & lit : *c) {
+    loccs_count (lit)++;
+    const unsigned ulit = vlit (lit);
+    if (loccs.contains (ulit)) loccs.update (ulit);
+  }
+  if (occurring () && c->size > 2)
+    for (const auto & lit : *c)
+      occs (lit).push_back (c);
+}
 
+void Internal::dec_loccs (Clause * c) {
+  assert (!c->redundant);
+  for (const auto & lit : *c)
+    dec_locc (lit);
+  if (!occurring () || c->garbage) return;
+  for (const auto & lit : *c) {
+    Occs & os = occs (lit);
+    const auto i = find (os.begin (), os.end (), c);
+    if (i != os.end ()) os.erase (i);
   }
+}
+
+// This returns the literal that appears most often in irredundant clauses
+// which is neither assigned nor assumed.  Inactive literals are removed
+// from the heap for good, while assigned and assumed literals are only
+// skipped and pushed back afterwards.
 
-  // This calculates the literal that appears the most often reusing the
-  // available datastructures and iterating over the clause set. This is too
-  // slow to be called iteratively. A faster (but inexact) version is
-  // lookahead_populate_loc and lookahead_loc.
 int Internal::most_occurring_literal () {
-  init_noccs ();
-  for (const auto & c : clauses)
-    if (!c->redundant)
-      for (const auto & lit : *c)
-        if (active (lit))
-          noccs (lit)++;
-  int64_t max_noccs = 0;
-  int res = 0;
+  assert (counting_loccs ());
 
   if(unsat)
     return INT_MIN;
 
   propagate();
-  for (int idx = 1; idx <= max_var; idx++) {
-    if (!active (idx) || assumed(idx) || assumed(-idx) || val(idx)) continue;
-    for (int sign = -1; sign <= 1; sign += 2) {
-      const int lit = sign * idx;
-      if (!active(lit))
-        continue;
-      int64_t tmp = noccs(lit);
-      if (tmp <= max_noccs)
-        continue;
-      max_noccs = tmp;
+
+  vector<unsigned> skipped;
+  int res = 0;
+  while (!loccs.empty ()) {
+    const unsigned ulit = loccs.front ();
+    if (!ltab[ulit]) break;
+    const int lit = u2i (ulit);
+    if (!active (lit)) { loccs.pop_front (); continue; }
+    if (!val (lit) && !assumed (lit) && !assumed (-lit)) {
       res = lit;
+      break;
     }
+    skipped.push_back (loccs.pop_front ());
   }
-  MSG ("maximum occurrence %" PRId64 " of literal %d", max_noccs, res);
-  reset_noccs ();
+  for (const auto & ulit : skipped)
+    loccs.push_back (ulit);
+
+  MSG ("maximum occurrence %" PRId64 " of literal %d",
+    res ? loccs_count (res) : 0, res);
   return res;
 }
 
@@ -364,7 +395,7 @@ int Internal::lookahead_probing() {
       MSG ("propagating units after probing results in empty clause");
       learn_empty_clause ();
       res = INT_MIN;
-    } else sort_watches ();
+    }
   }
 
 #ifndef QUIET
@@ -387,11 +418,434 @@ int Internal::lookahead_probing() {
   return res;
 }
 
-CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
+/*------------------------------------------------------------------------*/
+
+// March-style lookahead (following the 'march' solvers by Marijn Heule)
+// enabled by 'opts.march' as alternative to 'lookahead_probing'.  The
+// cube (the current assumptions) is assigned first, each literal on its
+// own decision level, which gives the 'base' level.  Then a limited
+// number of preselected candidate variables are looked ahead on in both
+// phases.  A literal is evaluated by the weighted number of clauses it
+// reduces without satisfying them, where clauses reduced to binary
+// clauses count most ('lookahead_reduced').  Failed literals and literals
+// implied by both phases of a candidate (necessary assignments) are
+// assigned on the base level and then the candidates are evaluated again
+// until no such units are found anymore.  Finally the variable with the
+// largest product of the evaluation of its two phases is selected.
+
+// The candidates are arranged in a forest along the binary implication
+// graph (tree-based lookahead as in the 'march' solvers), where a literal
+// is looked ahead on top of the assignment of its parent, which it
+// implies.  Thus the implications shared with the parent are only
+// propagated once.  If a literal reduces more clauses than the literals
+// tried before in double lookahead, we further look ahead on all other
+// candidates on top of it, which gives local failed literals and might
+// show that the literal fails too.
+
+// Necessary assignments and units found in double lookahead are not
+// implied by unit propagation and thus can not be traced in a clausal
+// proof.  Without cube these two are only derived if proof tracing is
+// disabled, while under a cube they are never learned anyhow.
+
+inline void Internal::lookahead_assign (int lit) {
+  require_mode (PROBE);
+  const int idx = vidx (lit);
+  assert (!vals[idx]);
+  assert (!flags (idx).eliminated ());
+  Var & v = var (idx);
+  v.level = level;
+  v.trail = (int) trail.size ();
+  v.reason = 0;
+  if (!level) learn_unit_clause (lit);
+  const signed char tmp = sign (lit);
+  vals[idx] = tmp;
+  vals[-idx] = -tmp;
+  assert (val (lit) > 0);
+  assert (val (-lit) < 0);
+  trail.push_back (lit);
+  LOG ("lookahead assign %d", lit);
+}
+
+void Internal::lookahead_assign_decision (int lit) {
+  require_mode (PROBE);
+  assert (propagated == trail.size ());
+  level++;
+  control.push_back (Level (lit, trail.size ()));
+  lookahead_assign (lit);
+}
+
+// Propagation policy and routine for lookahead similar to 'probe_propagate'
+// in 'probe.cpp', which also propagates binary clauses first, but works on
+// all decision levels and does not perform hyper binary resolution.
+
+struct LookaheadPropagation {
+
+  static const bool simd = false;
+  static const bool ignore = false;
+  static const bool ternary = true;
+
+  Internal * internal;
+
+  LookaheadPropagation (Internal * i) : internal (i) { }
+
+  bool vectorize () const { return false; }
+
+  void assign (int lit, Clause *, int) { internal->lookahead_assign (lit); }
+
+  bool assign (int lit, Clause *) {
+    internal->lookahead_assign (lit);
+    return false;
+  }
+};
+
+bool Internal::lookahead_propagate () {
+  require_mode (PROBE);
+  assert (!unsat);
+  START (propagate);
+  LookaheadPropagation policy (this);
+  int64_t before = propagated2 = propagated;
+  while (!conflict) {
+    if (propagated2 != trail.size ()) {
+      const int lit = -trail[propagated2++];
+      LOG ("lookahead propagating %d over binary clauses", -lit);
+      propagate_binary_watches (policy, lit);
+    } else if (propagated != trail.size ()) {
+      const int lit = -trail[propagated++];
+      LOG ("lookahead propagating %d over large clauses", -lit);
+      propagate_watches (policy, lit);
+    } else break;
+  }
+  int64_t delta = propagated2 - before;
+  stats.propagations.probe += delta;
+  if (conflict) LOG (conflict, "conflict");
+  STOP (propagate);
+  return !conflict;
+}
+
+// Weighted number of irredundant clauses reduced but not satisfied by the
+// literals on the trail starting at 'begin'.  A clause reduced to 'size'
+// literals has weight '0.2^(size-2)'.  Clauses already reduced by earlier
+// literals of the lookahead (above the 'base' level) are only counted once.
+// In tree-based lookahead this keeps the weight computed for the parent
+// for clauses the child reduces further.
+
+double Internal::lookahead_reduced (size_t begin, int base) {
+  double res = 0;
+  for (size_t i = begin; i < trail.size (); i++) {
+    const int lit = trail[i];
+    for (const auto & c : occs (-lit)) {
+      if (c->garbage) continue;
+      int unassigned = 0;
+      bool skip = false;
+      for (const auto & other : *c) {
+        const signed char tmp = val (other);
+        if (!tmp) unassigned++;
+        else if (tmp > 0) skip = true;
+        else if (other != -lit) {
+          const Var & v = var (other);
+          skip = v.level > base && v.trail < (int) i;
+        }
+        if (skip) break;
+      }
+      if (skip) continue;
+      assert (unassigned > 1);
+      double weight = 1;
+      while (unassigned-- > 2) weight *= 0.2;
+      res += weight;
+    }
+  }
+  return res;
+}
+
+// Preselect candidate variables by the product of the number of
+// irredundant occurrences of their two phases (and their sum for ties).
+
+struct march_preselect_more {
+  Internal * internal;
+  march_preselect_more (Internal * i) : internal (i) { }
+  bool operator () (int a, int b) const {
+    const int64_t p = internal->loccs_count (a);
+    const int64_t n = internal->loccs_count (-a);
+    const int64_t q = internal->loccs_count (b);
+    const int64_t m = internal->loccs_count (-b);
+    if (p*n != q*m) return p*n > q*m;
+    if (p + n != q + m) return p + n > q + m;
+    return a < b;
+  }
+};
+
+void Internal::march_select (March & march) {
+  assert (counting_loccs ());
+  for (const auto & c : march.candidates)
+    march.index[vlit (c.lit)] = -1;
+  march.candidates.clear ();
+  vector<int> selected;
+  for (auto idx : vars)
+    if (active (idx) && !val (idx))
+      selected.push_back (idx);
+  const size_t limit = opts.marchcands;
+  if (selected.size () > limit) {
+    nth_element (selected.begin (), selected.begin () + limit,
+                 selected.end (), march_preselect_more (this));
+    selected.resize (limit);
+  }
+  for (const auto & idx : selected)
+    for (int sign = 1; sign >= -1; sign -= 2) {
+      const int lit = sign * idx;
+      march.index[vlit (lit)] = march.candidates.size ();
+      march.candidates.push_back (MarchCandidate (lit));
+    }
+  LOG ("selected %zd lookahead candidates", march.candidates.size ());
+}
+
+// Connect each candidate to the first candidate it implies through a
+// binary clause unless that closes a cycle.
+
+void Internal::march_forest (March & march) {
+  auto & candidates = march.candidates;
+  for (size_t i = 0; i < candidates.size (); i++) {
+    MarchCandidate & c = candidates[i];
+    for (const auto & w : binary_watches (-c.lit)) {
+      const int j = march.index[vlit (w.blit)];
+      if (j < 0) continue;
+      if (watched_clause (w)->garbage) continue;
+      int k = j;
+      while (k >= 0 && k != (int) i) k = candidates[k].parent;
+      if (k >= 0) continue;
+      LOG ("lookahead literal %d below %d", c.lit, w.blit);
+      c.parent = j;
+      c.sibling = candidates[j].child;
+      candidates[j].child = i;
+      break;
+    }
+  }
+}
+
+// Double lookahead on top of the decision of the current decision level.
+// Returns 'true' if this decision failed, in which case we backtracked to
+// the previous level.
+
+bool Internal::march_double (March & march) {
+  const int current = level;
+  LOG ("double lookahead on %d", control[current].decision);
+  for (const auto & c : march.candidates) {
+    const int other = c.lit;
+    if (val (other)) continue;
+    stats.probed++;
+    lookahead_assign_decision (other);
+    const bool ok = lookahead_propagate ();
+    backtrack (current);
+    if (ok) continue;
+    conflict = 0;
+    LOG ("double lookahead on %d implies %d",
+      control[current].decision, -other);
+    lookahead_assign (-other);
+    if (lookahead_propagate ()) continue;
+    LOG ("double lookahead on %d failed", control[current].decision);
+    backtrack (current - 1);
+    conflict = 0;
+    return true;
+  }
+  return false;
+}
+
+// Look ahead on candidate 'idx' on top of the assignment of its parent
+// which has evaluation 'diff' and then recursively on its children.
+
+void Internal::march_evaluate (March & march, int idx, double diff) {
+  MarchCandidate * c = &march.candidates[idx];
+  const int lit = c->lit;
+  const signed char tmp = val (lit);
+  if (tmp < 0) {
+    LOG ("lookahead literal %d falsified by its parent", lit);
+    march.units.push_back (-lit);
+    return;
+  }
+  if (!tmp) {
+    const size_t begin = trail.size ();
+    stats.probed++;
+    lookahead_assign_decision (lit);
+    if (!lookahead_propagate ()) {
+      LOG ("failed lookahead literal %d", lit);
+      backtrack (level - 1);
+      conflict = 0;
+      march.units.push_back (-lit);
+      return;
+    }
+    diff += lookahead_reduced (begin, march.base);
+    if (march.derive && opts.marchdouble && diff > march.trigger) {
+      const size_t before = trail.size ();
+      if (march_double (march)) {
+        march.units.push_back (-lit);
+        return;
+      }
+      if (trail.size () == before) march.trigger = diff;
+    }
+  }
+  assert (level > march.base);
+  const int assigned = tmp ? 0 : level;
+  LOG ("lookahead literal %d reduces %g clauses", lit, diff);
+  c->diff = diff;
+  c->evaluated = true;
+
+  if (march.derive) {
+    const size_t begin = control[march.base + 1].trail;
+    MarchCandidate & d = march.candidates[march.index[vlit (-lit)]];
+    if (d.evaluated) {
+      for (size_t i = begin; i < trail.size (); i++)
+        mark (trail[i]);
+      for (const auto & other : d.implied)
+        if (marked (other) > 0) {
+          LOG ("necessary assignment %d", other);
+          march.units.push_back (other);
+        }
+      for (size_t i = begin; i < trail.size (); i++)
+        unmark (trail[i]);
+      erase_vector (d.implied);
+    } else c->implied.assign (trail.begin () + begin, trail.end ());
+  }
+
+  for (int child = c->child; child >= 0;
+       child = march.candidates[child].sibling)
+    march_evaluate (march, child, diff);
+
+  if (assigned) backtrack (assigned - 1);
+}
+
+// Assign failed literals and necessary assignments on the base level.
+// Returns 'false' if this refutes the cube or without cube the formula.
+
+bool Internal::march_units (March & march) {
+  assert (level == march.base);
+  for (const auto & lit : march.units) {
+    const signed char tmp = val (lit);
+    if (tmp > 0) continue;
+    if (!tmp) {
+      lookahead_assign (lit);
+      if (lookahead_propagate ()) continue;
+    }
+    LOG ("lookahead unit %d refutes cube", lit);
+    if (!march.base) learn_empty_clause ();
+    return false;
+  }
+  march.units.clear ();
+  return true;
+}
+
+// Select the phase reducing more clauses of the variable with the largest
+// product of the evaluations of both phases.
+
+int Internal::march_decide (March & march) {
+  double best = -1;
+  int res = 0;
+  for (size_t i = 0; i < march.candidates.size (); i += 2) {
+    const MarchCandidate & pos = march.candidates[i];
+    const MarchCandidate & neg = march.candidates[i + 1];
+    assert (pos.lit == -neg.lit);
+    if (!pos.evaluated || !neg.evaluated) continue;
+    const double score = 1024*pos.diff*neg.diff + pos.diff + neg.diff;
+    if (score <= best) continue;
+    best = score;
+    res = pos.diff < neg.diff ? neg.lit : pos.lit;
+  }
+  LOG ("march decision %d with score %g", res, best);
+  return res;
+}
+
+int Internal::lookahead_march () {
+
+  if (!active ())
+    return 0;
+
+  assert (counting_loccs ());
+
+  MSG ("march lookahead with %zu assumptions", assumptions.size ());
+
+  termination_forced = false;
+
+  if (unsat) return INT_MIN;
+  if (level) backtrack ();
+  if (!propagate ()) {
+    MSG ("empty clause before lookahead");
+    learn_empty_clause ();
+    return INT_MIN;
+  }
+
+  if (terminating_asked ())
+    return most_occurring_literal ();
+
+  decompose ();
+  if (unsat) return INT_MIN;
+
+  assert (occurring ());
+
+  March march;
+  march.index.resize (2 + 2*(size_t) max_var, -1);
+
+  set_mode (PROBE);
+
+  bool refuted = false;
+  for (const auto & lit : assumptions) {
+    const signed char tmp = val (lit);
+    if (tmp > 0) continue;
+    if (tmp < 0) { refuted = true; break; }
+    lookahead_assign_decision (lit);
+    if (lookahead_propagate ()) continue;
+    refuted = true;
+    break;
+  }
+  march.base = level;
+  march.derive = level || !proof;
+
+  int res = 0;
+  bool terminated = false;
+  while (!refuted) {
+    if (terminating_asked ()) { terminated = true; break; }
+    march_select (march);
+    if (march.candidates.empty ()) break;
+    march_forest (march);
+    for (size_t i = 0; i < march.candidates.size (); i++)
+      if (march.candidates[i].parent < 0)
+        march_evaluate (march, i, 0);
+    assert (level == march.base);
+    if (march.units.empty ()) { res = march_decide (march); break; }
+    if (!march_units (march)) refuted = true;
+  }
+
+  if (refuted) {
+    MSG ("lookahead refuted cube");
+    conflict = 0;
+    res = INT_MIN;
+  }
+
+  backtrack ();
+  reset_mode (PROBE);
+
+  if (!unsat && propagated < trail.size () && !propagate ()) {
+    MSG ("propagating units after lookahead results in empty clause");
+    learn_empty_clause ();
+  }
+
+  if (unsat) res = INT_MIN;
+  else if (terminated) res = most_occurring_literal ();
+
+  MSG ("march lookahead literal %d", res);
+
+  return res;
+}
+
+// Cubes are generated depth-first.  The current cube is split on the
+// literal returned by lookahead (or on the most occurring literal if
+// termination is requested) and both new cubes are pushed on a stack,
+// such that the one with the positive literal is split next.  Cubes which
+// can not be split, reached 'depth' or after termination was requested
+// are deeper than 'min_depth', are given to the iterator immediately.
+// Thus only the stack of at most 'depth' cubes is kept in memory.
+
+int Internal::generate_cubes (int depth, int min_depth, CubeIterator & it) {
   if (!active() || depth == 0) {
-    CubesWithStatus cubes;
-    cubes.cubes.push_back(std::vector<int>());
-    return cubes;
+    it.cube (assumptions);
+    return 0;
   }
 
   lookingahead = true;
@@ -410,35 +864,38 @@ CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
     res = solve(true);
   if (res != 0) {
     MSG("Solved during preprocessing");
-    CubesWithStatus cubes;
-    cubes.status = res;
-    cubes.status = 20;
     lookingahead = false;
     STOP(lookahead);
-    return cubes;
+    return res;
   }
 
   reset_limits();
   MSG ("generate cubes with %zu assumptions\n", assumptions.size());
 
   assert(ntab.empty());
-  std::vector<int> current_assumptions{assumptions};
-  std::vector<std::vector<int>> cubes {{assumptions}};
-  auto loccs{lookahead_populate_locc()};
+  const std::vector<int> current_assumptions{assumptions};
+  std::vector<std::vector<int>> stack {{assumptions}};
+  init_loccs();
   LOG("loccs populated\n");
   assert(ntab.empty());
 
-  for (int i = 0; i < depth; ++i) {
-    LOG("Probing at depth %i, currently %zu have been generated",
-        i, cubes.size());
-    std::vector<std::vector<int>> cubes2 {std::move(cubes)};
-    cubes.clear ();
+  int64_t generated = 0;
+
+  while (!stack.empty ()) {
+    std::vector<int> cube {std::move (stack.back ())};
+    stack.pop_back ();
+
+    const int cube_depth = cube.size () - current_assumptions.size ();
+    LOG("Probing at depth %i, currently %" PRId64 " have been generated",
+        cube_depth, generated);
 
-    for (size_t j = 0; j < cubes2.size(); ++j) {
+    int split = 0;
+    if (cube_depth < depth &&
+        (cube_depth <= min_depth || !terminating_asked())) {
       assert(ntab.empty());
       assert(!unsat);
       reset_assumptions();
-      for (auto lit : cubes2[j])
+      for (auto lit : cube)
         assume(lit);
       restore_clauses();
       propagate();
@@ -450,35 +907,40 @@ CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
         continue;
       }
 
-      int res = terminating_asked()  ? lookahead_locc(loccs) : lookahead_probing();
+      split = terminating_asked()  ? most_occurring_literal()
+            : opts.march ? lookahead_march() : lookahead_probing();
       if(unsat) {
         LOG("current cube is unsat; skipping");
         unsat = false;
         continue;
       }
 
-      if (res == 0) {
-        LOG("no lit to split %i", res);
-        cubes.push_back(cubes2[j]);
+      if (split == INT_MIN) {
+        LOG("current cube is refuted by lookahead; skipping");
         continue;
       }
+    }
 
-      assert(res != 0);
-      LOG("splitting on lit %i", res);
-      std::vector<int> cube1{cubes2[j]};
-      cube1.push_back(res);
-      std::vector<int> cube2{std::move(cubes2[j])};
-      cube2.push_back(-res);
-      cubes.push_back(cube1);
-      cubes.push_back(cube2);
+    if (split == 0) {
+      assert(non_tautological_cube (cube));
+      generated++;
+      if (!it.cube (cube)) {
+        LOG("cube iterator asked to stop");
+        break;
+      }
+      continue;
     }
 
-    if (terminating_asked() && i >= min_depth)
-      break;
+    LOG("splitting on lit %i", split);
+    std::vector<int> other{cube};
+    other.push_back(-split);
+    cube.push_back(split);
+    stack.push_back(std::move(other));
+    stack.push_back(std::move(cube));
   }
 
-  assert(std::for_each(std::begin(cubes), std::end(cubes), [](std::vector<int> cube){return non_tautological_cube (cube);}));
   reset_assumptions();
+  reset_loccs();
 
   for(auto lit : current_assumptions)
     assume(lit);
@@ -486,19 +948,9 @@ CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
   STOP(lookahead);
   lookingahead = false;
 
-  if (unsat) {
-    LOG("Solved during preprocessing");
-    CubesWithStatus cubes;
-    cubes.status = 20;
-    cubes.status = res;
-    return cubes;
-  }
-
-  CubesWithStatus rcubes;
-  rcubes.status = 0;
-  rcubes.cubes = cubes;
+  MSG ("generated %" PRId64 " cubes", generated);
 
-  return rcubes;
+  return unsat ? 20 : 0;
 }
 
 } // namespace CaDiCaL
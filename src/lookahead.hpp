@@ -0,0 +1,49 @@
+#ifndef _lookahead_hpp_INCLUDED
+#define _lookahead_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+// Literals (mapped with 'vlit') ordered by their number of occurrences in
+// irredundant clauses, which during lookahead is kept up-to-date in 'ltab'
+// as clauses are added, shrunken and removed (see 'lookahead.cpp').  Ties
+// are broken in favor of smaller variables and negative literals.
+
+struct locc_smaller {
+  Internal * internal;
+  locc_smaller (Internal * i) : internal (i) { }
+  bool operator () (unsigned a, unsigned b);
+};
+
+typedef heap<locc_smaller> LoccSchedule;
+
+// Candidate literal of the march-style lookahead in 'lookahead_march'.
+// Candidates are arranged in a forest following the binary implication
+// graph, where a 'child' implies its 'parent', and thus can be looked
+// ahead on top of the assignment of its parent.  Otherwise the fields are
+// indices into 'March::candidates' or negative if missing.
+
+struct MarchCandidate {
+  int lit;
+  int parent, child, sibling;
+  double diff;                  // weighted number of reduced clauses
+  bool evaluated;
+  vector<int> implied;          // until negation is evaluated
+  MarchCandidate (int l) :
+    lit (l), parent (-1), child (-1), sibling (-1),
+    diff (0), evaluated (false)
+  { }
+};
+
+struct March {
+  vector<MarchCandidate> candidates;
+  vector<int> index;            // 'vlit' to candidate index
+  vector<int> units;            // failed literals and necessary assignments
+  int base;                     // decision level of the cube
+  bool derive;                  // necessary assignments and double lookahead
+  double trigger;               // minimum 'diff' for double lookahead
+  March () : base (0), derive (false), trigger (0) { }
+};
+
+}
+
+#endif
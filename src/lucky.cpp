@@ -293,7 +293,7 @@ int Internal::lucky_phases () {
   if (!res) res = backward_true_satisfiable ();
   if (!res) res = positive_horn_satisfiable ();
   if (!res) res = negative_horn_satisfiable ();
-  if (res < 0) assert (termination_forced), res = 0;
+  if (res < 0) assert (termination_forced || lim.memory.exceeded), res = 0;
   if (res == 10) stats.lucky.succeeded++;
   report ('l', !res);
   assert (searching_lucky_phases);
@@ -0,0 +1,85 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+// Support for a hard memory budget in MB, given either by 'opts.memorylimit'
+// or for the next 'solve' call by 'limit ("memory", ...)'.  We do not try
+// to count every allocated byte but estimate the memory used by the large
+// data structures, i.e., the clauses (in and outside of the arena),
+// watches, occurrence lists, variable tables and the internal proof
+// checker.  Since this takes time linear in the number of clauses, the
+// estimate is only computed at the start of 'solve', after garbage
+// collection and when 'reduce', 'probe', 'subsume' and 'elim' start (the
+// latter also after connecting occurrence lists).
+
+// If the estimate reaches 'memory_pressure_percent' of the limit, the
+// solver is under memory pressure.  Then 'reduce' flushes all unused
+// redundant clauses and is scheduled twice as often, memory hungry
+// inprocessors using occurrence lists ('elim', 'cover' and 'block') are
+// skipped, learned clauses are not allocated in the nursery anymore and
+// garbage collection is performed in place (without a 'to' space).  As
+// soon as the limit is exceeded preprocessing, inprocessing and search are
+// stopped as if terminated and 'solve' returns zero (UNKNOWN).
+
+static const int memory_pressure_percent = 80;
+
+size_t Internal::memory_usage () {
+
+  size_t res = arena.bytes ();
+
+  for (const auto & c : clauses) {
+    if (arena.contains (c)) continue;
+#ifndef WATCH32
+    if (arena.young_contains (c)) continue;
+#endif
+    res += c->bytes ();
+  }
+
+  res += clauses.capacity () * sizeof (Clause *);
+
+  res += watchstore.bytes ();
+  for (const auto & os : otab) res += os.capacity () * sizeof (Clause *);
+
+  res += wtab.capacity () * sizeof (Watches);
+  res += bwtab.capacity () * sizeof (Watches);
+  res += otab.capacity () * sizeof (Occs);
+  res += ntab.capacity () * sizeof (int64_t);
+  res += vtab.capacity () * sizeof (Var);
+  res += links.capacity () * sizeof (Link);
+  res += ftab.capacity () * sizeof (Flags);
+  res += ptab.capacity () * sizeof (int);
+  res += btab.capacity () * sizeof (int64_t);
+  res += stab.capacity () * sizeof (double);
+  res += 2 * vsize * sizeof (signed char);
+  res += trail.capacity () * sizeof (int);
+
+  if (checker) res += checker->bytes ();
+
+  return res;
+}
+
+int Internal::memory_limit () const {
+  return inc.memory > 0 ? (int) inc.memory : opts.memorylimit;
+}
+
+void Internal::check_memory_limit () {
+  const int mb = memory_limit ();
+  if (!mb) return;
+  const size_t limit = (size_t) mb << 20;
+  const size_t usage = memory_usage ();
+  const bool pressure = 100.0 * usage >= memory_pressure_percent * (double) limit;
+  if (pressure && !lim.memory.pressure)
+    VERBOSE (1, "memory usage %.0f MB close to limit of %d MB",
+      usage / (double) (1 << 20), mb);
+  else if (!pressure && lim.memory.pressure)
+    VERBOSE (1, "memory usage %.0f MB back below %d%% of limit",
+      usage / (double) (1 << 20), memory_pressure_percent);
+  if (usage > limit && !lim.memory.exceeded) {
+    VERBOSE (1, "memory usage %.0f MB exceeds limit of %d MB",
+      usage / (double) (1 << 20), mb);
+    lim.memory.exceeded = true;
+  }
+  lim.memory.pressure = pressure;
+}
+
+}
@@ -21,6 +21,9 @@
 \
 OPTION( arena,             1,  0,  1,0,0,1, "allocate clauses in arena") \
 OPTION( arenacompact,      1,  0,  1,0,0,1, "keep clauses compact") \
+OPTION( arenagen,          1,  0,  1,0,0,1, "generational garbage collection") \
+OPTION( arenagenlim,      50,  1,1e3,0,0,1, "major collection limit in percent") \
+OPTION( arenanursery,      1,  0,  1,0,0,1, "allocate learned clauses in arena") \
 OPTION( arenasort,         1,  0,  1,0,0,1, "sort clauses in arena") \
 OPTION( arenatype,         3,  1,  3,0,0,1, "1=clause, 2=var, 3=queue") \
 OPTION( binary,            1,  0,  1,0,0,1, "use binary proof format") \
@@ -57,6 +60,8 @@ OPTION( covermaxeff,     1e8,  0,2e9,1,0,1, "maximum cover efficiency") \
 OPTION( coverminclslim,    2,  2,2e9,0,0,1, "minimum clause size") \
 OPTION( covermineff,     1e6,  0,2e9,1,0,1, "minimum cover efficiency") \
 OPTION( coverreleff,       4,  1,1e5,1,0,1, "relative efficiency per mille") \
+OPTION( cubelimit,       1e3,  1,2e9,0,0,1, "initial conflict limit per cube") \
+OPTION( cubes,             0,  0, 20,0,0,1, "cube depth for portfolio and '--icnf'") \
 OPTION( decompose,         1,  0,  1,0,1,1, "decompose BIG in SCCs and ELS") \
 OPTION( decomposerounds,   2,  1, 16,1,0,1, "number of decompose rounds") \
 OPTION( deduplicate,       1,  0,  1,0,1,1, "remove duplicated binaries") \
@@ -93,6 +98,7 @@ OPTION( flush,             0,  0,  1,0,0,1, "flush redundant clauses") \
 OPTION( flushfactor,       3,  1,1e3,0,0,1, "interval increase") \
 OPTION( flushint,        1e5,  1,2e9,0,0,1, "initial limit") \
 OPTION( forcephase,        0,  0,  1,0,0,1, "always use initial phase") \
+OPTION( hugepages,         0,  0,  1,0,0,1, "transparent huge pages") \
 OPTION( inprocessing,      1,  0,  1,0,0,1, "enable inprocessing") \
 OPTION( instantiate,       0,  0,  1,0,1,1, "variable instantiation") \
 OPTION( instantiateclslim, 3,  2,2e9,0,0,1, "minimum clause size") \
@@ -101,8 +107,13 @@ OPTION( instantiateonce,   1,  0,  1,0,0,1, "instantiate each clause once") \
 LOGOPT( log,               0,  0,  1,0,0,0, "enable logging") \
 LOGOPT( logsort,           0,  0,  1,0,0,0, "sort logged clauses") \
 OPTION( lucky,             1,  0,  1,0,0,1, "search for lucky phases") \
+OPTION( march,             0,  0,  1,0,0,1, "march-style lookahead for cubes") \
+OPTION( marchcands,      100,  1,1e5,0,0,1, "lookahead candidate variables") \
+OPTION( marchdouble,       1,  0,  1,0,0,1, "double lookahead") \
+OPTION( memorylimit,       0,  0,2e9,0,0,1, "memory limit in MB (0=none)") \
 OPTION( minimize,          1,  0,  1,0,0,1, "minimize learned clauses") \
 OPTION( minimizedepth,   1e3,  0,1e3,0,0,1, "minimization depth") \
+OPTION( parsethreads,      1,  1, 64,0,0,0, "threads for parsing large files") \
 OPTION( phase,             1,  0,  1,0,0,1, "initial phase") \
 OPTION( probe,             1,  0,  1,0,1,1, "failed literal probing" ) \
 OPTION( probehbr,          1,  0,  1,0,0,1, "learn hyper binary clauses") \
@@ -137,12 +148,22 @@ OPTION( reverse,           0,  0,  1,0,0,1, "reverse variable ordering") \
 OPTION( score,             1,  0,  1,0,0,1, "use EVSIDS scores") \
 OPTION( scorefactor,     950,500,1e3,0,0,1, "score factor per mille") \
 OPTION( seed,              0,  0,2e9,0,0,1, "random seed") \
+OPTION( share,             1,  0,  1,0,0,1, "share clauses in portfolio") \
+OPTION( sharebuffer,      16, 10, 30,0,0,1, "log2 shared buffer size") \
+OPTION( sharedup,          1,  0,  1,0,0,1, "filter duplicated shared clauses") \
+OPTION( sharedupage,     1e4,  0,2e9,0,0,1, "duplicate filter age in conflicts") \
+OPTION( sharedupsize,     16,  8, 30,0,0,1, "log2 duplicate filter size") \
+OPTION( shareglue,         2,  1,2e9,0,0,1, "maximum shared glue") \
+OPTION( sharereactivate,   0,  0,1e5,0,0,1, "reactivated imported variables per batch") \
+OPTION( sharerepr,         0,  0,  1,0,0,1, "import substituted as representatives") \
+OPTION( sharesize,         8,  1,2e9,0,0,1, "maximum shared size") \
 OPTION( shrink,            3,  0,  3,0,0,1, "shrink conflict clause") \
 OPTION( shrinkreap,        1,  0,  1,0,0,1, "use a reap for shrinking") \
 OPTION( shuffle,           0,  0,  1,0,0,1, "shuffle variables") \
 OPTION( shufflequeue,      1,  0,  1,0,0,1, "shuffle variable queue") \
 OPTION( shufflerandom,     0,  0,  1,0,0,1, "not reverse but random") \
 OPTION( shufflescores,     1,  0,  1,0,0,1, "shuffle variable scores") \
+OPTION( simd,              0,  0,  1,0,0,1, "vectorized blocking literal scan") \
 OPTION( stabilize,         1,  0,  1,0,0,1, "enable stabilizing phases") \
 OPTION( stabilizefactor, 200,101,2e9,0,0,1, "phase increase in percent") \
 OPTION( stabilizeint,    1e3,  1,2e9,0,0,1, "stabilizing interval") \
@@ -167,6 +188,8 @@ OPTION( ternarymineff,   1e6,  1,2e9,1,0,1, "minimum ternary efficiency") \
 OPTION( ternaryocclim,   1e2,  1,2e9,2,0,1, "ternary occurrence limit") \
 OPTION( ternaryreleff,    10,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( ternaryrounds,     2,  1, 16,1,0,1, "maximum ternary rounds") \
+OPTION( tlbmisses,reportdefault,0,1,0,0,0, "count TLB misses of solving thread") \
+OPTION( trailsave,         0,  0,  1,0,0,1, "save and replay trail") \
 OPTION( transred,          1,  0,  1,0,1,1, "transitive reduction of BIG") \
 OPTION( transredmaxeff,  1e8,  0,2e9,1,0,1, "maximum efficiency") \
 OPTION( transredmineff,  1e6,  0,2e9,1,0,1, "minimum efficiency") \
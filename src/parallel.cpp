@@ -0,0 +1,517 @@
+#include "internal.hpp"
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// See 'parallel.hpp' for the data structures and 'cadical.hpp' for the
+// API of the parallel portfolio solver.  The workers are ordinary solvers
+// connected to learned clause export and import call-backs.  Clauses are
+// imported by the solver before decisions on any decision level (see
+// 'import_redundant_clauses').
+
+/*------------------------------------------------------------------------*/
+
+ClauseRing::ClauseRing (unsigned log2size) :
+  buffer ((size_t) 1 << log2size),
+  mask (((uint64_t) 1 << log2size) - 1),
+  written (0), read (0)
+{
+}
+
+bool ClauseRing::push (const int * begin, const int * end) {
+  const uint64_t w = written.load (std::memory_order_relaxed);
+  const uint64_t r = read.load (std::memory_order_acquire);
+  if (w - r + (end - begin) > buffer.size ()) return false;
+  uint64_t pos = w;
+  for (const int * p = begin; p != end; p++)
+    buffer[pos++ & mask] = *p;
+  written.store (pos, std::memory_order_release);
+  return true;
+}
+
+bool ClauseRing::empty () const {
+  const uint64_t r = read.load (std::memory_order_relaxed);
+  return r == written.load (std::memory_order_acquire);
+}
+
+// Pop a single clause in the format of 'LearnSource::getNextClause'.
+
+void ClauseRing::pop (vector<int> & clause) {
+  uint64_t pos = read.load (std::memory_order_relaxed);
+  assert (pos != written.load (std::memory_order_acquire));
+  const int glue = buffer[pos++ & mask];
+  clause.clear ();
+  if (glue) clause.push_back (glue);
+  int lit;
+  while ((lit = buffer[pos++ & mask]))
+    clause.push_back (lit);
+  assert (glue || clause.size () == 1);
+  read.store (pos, std::memory_order_release);
+}
+
+// Append all published clauses to 'batch' with at most two copies.
+
+void ClauseRing::pop_all (vector<int> & batch) {
+  const uint64_t r = read.load (std::memory_order_relaxed);
+  const uint64_t w = written.load (std::memory_order_acquire);
+  if (r == w) return;
+  const int * data = buffer.data ();
+  const uint64_t begin = r & mask, end = w & mask;
+  if (begin < end) batch.insert (batch.end (), data + begin, data + end);
+  else {
+    batch.insert (batch.end (), data + begin, data + buffer.size ());
+    batch.insert (batch.end (), data, data + end);
+  }
+  read.store (w, std::memory_order_release);
+}
+
+/*------------------------------------------------------------------------*/
+
+void CubeQueue::push (Cube & cube) {
+  std::lock_guard<std::mutex> guard (lock);
+  cubes.push_back (std::move (cube));
+}
+
+bool CubeQueue::pop (Cube & cube) {
+  std::lock_guard<std::mutex> guard (lock);
+  if (cubes.empty ()) return false;
+  cube = std::move (cubes.back ());
+  cubes.pop_back ();
+  return true;
+}
+
+bool CubeQueue::steal (Cube & cube) {
+  std::lock_guard<std::mutex> guard (lock);
+  if (cubes.empty ()) return false;
+  cube = std::move (cubes.front ());
+  cubes.pop_front ();
+  return true;
+}
+
+void CubeQueue::clear () {
+  std::lock_guard<std::mutex> guard (lock);
+  cubes.clear ();
+}
+
+/*------------------------------------------------------------------------*/
+
+Worker::Worker (Portfolio * p, Solver * s, int i) :
+  portfolio (p), solver (s), id (i), refuted (0), res (0)
+{
+  memset (&stats, 0, sizeof stats);
+}
+
+// Learned clauses are buffered by the solver and flushed at restarts
+// already in the batch format of 'LearnSource', within the size and glue
+// limits given when connecting the worker.  Each clause is pushed to each
+// ring separately, so a full ring only drops the clauses not fitting.
+
+void Worker::learn (const int * begin, const int * end) {
+  const int * p = begin;
+  while (p != end) {
+    const int * clause = p++;
+    while (*p++)
+      ;
+    for (const auto & ring : out)
+      if (ring->push (clause, p)) stats.exported++;
+      else stats.dropped++;
+  }
+}
+
+// The solver polls 'hasNextClause' before every decision, thus it only
+// checks the rings, and then imports clauses as long as it returns true,
+// first all available batches and then single clauses.
+
+bool Worker::hasNextClause () {
+  for (const auto & ring : in)
+    if (!ring->empty ())
+      return true;
+  return false;
+}
+
+const vector<int> & Worker::getNextClause () {
+  for (const auto & ring : in)
+    if (!ring->empty ()) {
+      ring->pop (importing);
+      break;
+    }
+  assert (!importing.empty ());
+  return importing;
+}
+
+bool Worker::getNextClauses (const int *& begin, const int *& end) {
+  batch.clear ();
+  for (const auto & ring : in)
+    ring->pop_all (batch);
+  if (batch.empty ()) return false;
+  begin = batch.data ();
+  end = begin + batch.size ();
+  return true;
+}
+
+bool Worker::terminate () {
+  if (portfolio->done.load (std::memory_order_relaxed)) return true;
+  if (id || !portfolio->terminator) return false;
+  if (!portfolio->terminator->terminate ()) return false;
+  portfolio->done = true;
+  return true;
+}
+
+void Worker::finish (int result) {
+  res = result;
+  int expected = -1;
+  portfolio->winner.compare_exchange_strong (expected, id);
+  portfolio->done = true;
+  portfolio->wake ();
+}
+
+void Worker::run () {
+  res = solver->solve ();
+  if (res) finish (res);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Take the next cube from the own queue and otherwise steal one from the
+// other workers, starting with the next worker to spread stealing.
+
+bool Worker::next_cube (Cube & cube) {
+  if (cubes.pop (cube)) return true;
+  const auto & workers = portfolio->workers;
+  const size_t size = workers.size ();
+  for (size_t i = 1; i < size; i++) {
+    Worker * victim = workers[(id + i) % size];
+    if (!victim->cubes.steal (cube)) continue;
+    stats.stolen++;
+    return true;
+  }
+  return false;
+}
+
+// Add all clauses of cubes refuted by other workers since the last call.
+
+void Worker::import_refuted () {
+  std::lock_guard<std::mutex> guard (portfolio->refuted_lock);
+  const auto & clauses = portfolio->refuted;
+  while (refuted < clauses.size ())
+    solver->add (clauses[refuted++]);
+}
+
+// As for incremental cubes in 'App::main' only the failed assumptions are
+// negated.  Without any failed assumption the formula is unsatisfiable.
+
+void Worker::refute (const Cube & cube) {
+  vector<int> clause;
+  for (const auto & lit : cube.lits)
+    if (solver->failed (lit))
+      clause.push_back (-lit);
+  stats.conquered++;
+  if (clause.empty ()) { finish (20); return; }
+  {
+    std::lock_guard<std::mutex> guard (portfolio->refuted_lock);
+    auto & clauses = portfolio->refuted;
+    clauses.insert (clauses.end (), clause.begin (), clause.end ());
+    clauses.push_back (0);
+  }
+  if (!--portfolio->pending) finish (20);
+}
+
+// Split a cube which hit its conflict limit on the active and unassigned
+// variable outside of the cube with the highest score (or the most
+// recently bumped variable in focused mode) after the search.  The saved
+// phase of that variable determines which of the two cubes the worker
+// solves next itself.  The other one can still be stolen.
+
+void Worker::split (Cube & cube) {
+  External * external = solver->external;
+  Internal * internal = solver->internal;
+  vector<bool> marks;
+  for (const auto & lit : cube.lits)
+    external->mark (marks, abs (lit));
+  int best = 0;
+  double best_score = -1;
+  for (int eidx = 1; eidx <= external->max_var; eidx++) {
+    if (external->marked (marks, eidx)) continue;
+    if (external->inactive (eidx)) continue;
+    const int ilit = external->e2i[eidx];
+    if (!ilit || internal->fixed (ilit)) continue;
+    const int idx = abs (ilit);
+    const double score = internal->use_scores () ?
+      internal->score (idx) : (double) internal->bumped (idx);
+    if (score <= best_score) continue;
+    best_score = score;
+    const int phase = internal->phases.saved[idx] < 0 ? -idx : idx;
+    best = phase == ilit ? eidx : -eidx;
+  }
+  const int64_t limit = 2*cube.limit;
+  cube.limit = limit < INT_MAX ? limit : INT_MAX;
+  if (best) {
+    Cube other { cube.lits, cube.limit };
+    other.lits.push_back (-best);
+    cube.lits.push_back (best);
+    portfolio->pending++;
+    cubes.push (other);
+    stats.split++;
+  }
+  cubes.push (cube);
+  if (best) portfolio->wake ();
+}
+
+// An idle worker blocks until cubes are split off or the portfolio is
+// done.  Since the external terminator is only checked in 'terminate' the
+// wait is bounded, such that an idle first worker still polls it.
+
+void Portfolio::wake () {
+  {
+    std::lock_guard<std::mutex> guard (idle_lock);
+    wakeups++;
+  }
+  idle.notify_all ();
+}
+
+void Portfolio::wait (uint64_t seen) {
+  std::unique_lock<std::mutex> guard (idle_lock);
+  idle.wait_for (guard, std::chrono::milliseconds (10), [&] {
+    return wakeups != seen || done.load (std::memory_order_relaxed);
+  });
+}
+
+void Worker::conquer () {
+  Cube cube;
+  while (!portfolio->done.load (std::memory_order_relaxed)) {
+    const uint64_t seen = portfolio->wakeups;
+    if (!next_cube (cube)) {
+      if (!terminate ()) portfolio->wait (seen);
+      continue;
+    }
+    import_refuted ();
+    for (const auto & lit : cube.lits)
+      solver->assume (lit);
+    solver->limit ("conflicts", (int) cube.limit);
+    const int tmp = solver->solve ();
+    if (tmp == 10) finish (10);
+    else if (tmp == 20) refute (cube);
+    else if (!portfolio->done) split (cube);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Diversification of the workers, where the first worker keeps the given
+// options.  The other workers use a different random seed and alternate
+// between the 'sat' and 'unsat' configurations, shuffling and always
+// using target phases.  Only the first worker reports progress.
+
+static void diversify (Options & opts, int id) {
+  if (!id) return;
+  opts.set ("seed", opts.seed + id);
+  opts.set ("report", 0);
+  opts.set ("tlbmisses", 0);
+  switch (id % 4) {
+    case 1: Config::set (opts, "sat"); break;
+    case 2: Config::set (opts, "unsat"); break;
+    case 3:
+      opts.set ("shuffle", 1);
+      opts.set ("shufflerandom", 1);
+      break;
+    default:
+      opts.set ("target", 2);
+      break;
+  }
+}
+
+ParallelSolver::ParallelSolver (int threads, const Solver * base) {
+  REQUIRE (threads > 0, "invalid number of threads '%d'", threads);
+  portfolio = new Portfolio ();
+  for (int id = 0; id < threads; id++) {
+    Solver * solver = new Solver ();
+    if (base) base->copy (*solver);
+    diversify (solver->internal->opts, id);
+    portfolio->workers.push_back (new Worker (portfolio, solver, id));
+  }
+}
+
+ParallelSolver::~ParallelSolver () {
+  for (const auto & worker : portfolio->workers) {
+    delete worker->solver;
+    delete worker;
+  }
+  for (const auto & ring : portfolio->rings)
+    delete ring;
+  delete portfolio;
+}
+
+int ParallelSolver::threads () const {
+  return (int) portfolio->workers.size ();
+}
+
+Solver * ParallelSolver::worker (int idx) {
+  REQUIRE (0 <= idx && idx < threads (), "invalid worker '%d'", idx);
+  return portfolio->workers[idx]->solver;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool ParallelSolver::set (const char * name, int val) {
+  bool res = true;
+  for (const auto & worker : portfolio->workers)
+    res &= worker->solver->set (name, val);
+  return res;
+}
+
+bool ParallelSolver::limit (const char * name, int val) {
+  bool res = true;
+  for (const auto & worker : portfolio->workers)
+    res &= worker->solver->limit (name, val);
+  return res;
+}
+
+void ParallelSolver::add (int lit) {
+  for (const auto & worker : portfolio->workers)
+    worker->solver->add (lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+// The rings and call-backs are connected lazily in the first 'solve' call
+// since the sharing options might still change before.  Clauses left in
+// the rings remain valid for later calls, since all workers only learn
+// clauses implied by the (growing) common formula.
+
+void ParallelSolver::connect_workers () {
+  assert (!portfolio->connected);
+  portfolio->connected = true;
+  auto & workers = portfolio->workers;
+  const size_t threads = workers.size ();
+  for (const auto & worker : workers)
+    worker->solver->connect_terminator (worker);
+  if (threads < 2 || !workers[0]->solver->internal->opts.share) return;
+  const unsigned log2size = workers[0]->solver->internal->opts.sharebuffer;
+  for (size_t src = 0; src < threads; src++) {
+    for (size_t dst = 0; dst < threads; dst++) {
+      if (src == dst) continue;
+      ClauseRing * ring = new ClauseRing (log2size);
+      portfolio->rings.push_back (ring);
+      workers[src]->out.push_back (ring);
+      workers[dst]->in.push_back (ring);
+    }
+  }
+  for (const auto & worker : workers) {
+    Solver * solver = worker->solver;
+    const Options & opts = solver->internal->opts;
+    solver->connect_batch_learner (worker, opts.sharesize, opts.shareglue);
+    solver->connect_learn_source (worker);
+  }
+}
+
+int ParallelSolver::run_workers (void (Worker::*fun) ()) {
+  auto & workers = portfolio->workers;
+#ifndef NTHREADS
+  vector<std::thread> running;
+  for (const auto & worker : workers)
+    running.push_back (std::thread (fun, worker));
+  for (auto & thread : running)
+    thread.join ();
+#else
+  (workers[0]->*fun) ();
+#endif
+  const int idx = portfolio->winner;
+  return idx < 0 ? 0 : workers[idx]->res;
+}
+
+int ParallelSolver::solve () {
+  const int depth = portfolio->workers[0]->solver->internal->opts.cubes;
+  if (depth) return conquer (depth);
+  if (!portfolio->connected) connect_workers ();
+  portfolio->done = false;
+  portfolio->winner = -1;
+  return run_workers (&Worker::run);
+}
+
+// The cubes are distributed round-robin.  If cube generation already
+// solved the formula (or did not produce any cube) we fall back to the
+// portfolio, which also provides a model or checks the result.
+
+int ParallelSolver::conquer (int depth) {
+  REQUIRE (depth >= 0, "invalid negative cube depth '%d'", depth);
+  auto & workers = portfolio->workers;
+  if (!portfolio->connected) connect_workers ();
+  portfolio->done = false;
+  portfolio->winner = -1;
+  Solver * first = workers[0]->solver;
+  auto generated = first->generate_cubes (depth);
+  if (generated.status || generated.cubes.empty ())
+    return run_workers (&Worker::run);
+  for (const auto & worker : workers)
+    worker->cubes.clear ();
+  const int64_t limit = first->internal->opts.cubelimit;
+  portfolio->pending = generated.cubes.size ();
+  size_t i = 0;
+  for (auto & lits : generated.cubes) {
+    Cube cube { std::move (lits), limit };
+    workers[i++ % workers.size ()]->cubes.push (cube);
+  }
+  first->message ("conquering %zu cubes of depth %d with %zu workers",
+    generated.cubes.size (), depth, workers.size ());
+  return run_workers (&Worker::conquer);
+}
+
+Solver * ParallelSolver::winner () {
+  const int idx = portfolio->winner;
+  return idx < 0 ? 0 : portfolio->workers[idx]->solver;
+}
+
+int ParallelSolver::val (int lit) {
+  Solver * solver = winner ();
+  REQUIRE (solver, "can only get value in satisfied state");
+  return solver->val (lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+void ParallelSolver::terminate () {
+  portfolio->done = true;
+  for (const auto & worker : portfolio->workers)
+    worker->solver->terminate ();
+}
+
+void ParallelSolver::connect_terminator (Terminator * terminator) {
+  REQUIRE (terminator, "can not connect zero terminator");
+  portfolio->terminator = terminator;
+}
+
+void ParallelSolver::disconnect_terminator () {
+  portfolio->terminator = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+void ParallelSolver::statistics () {
+  Solver * first = portfolio->workers[0]->solver;
+  first->section ("portfolio");
+  for (const auto & worker : portfolio->workers) {
+    const Solver::Statistics s = worker->solver->get_stats ();
+    first->message (
+      "worker %d: %" PRId64 " conflicts, exported %" PRId64
+      " dropped %" PRId64 " imported %lu discarded %lu duplicated %lu%s",
+      worker->id, s.conflicts,
+      worker->stats.exported, worker->stats.dropped,
+      s.imported, s.discarded, s.r_dup + s.e_dup,
+      worker->id == portfolio->winner ? " (winner)" : "");
+    if (worker->stats.conquered || worker->stats.split)
+      first->message (
+        "worker %d: refuted %" PRId64 " cubes, split %" PRId64
+        " stole %" PRId64, worker->id, worker->stats.conquered,
+        worker->stats.split, worker->stats.stolen);
+  }
+  Solver * solver = winner ();
+  if (!solver) solver = first;
+  solver->statistics ();
+}
+
+}
@@ -0,0 +1,163 @@
+#ifndef _parallel_hpp_INCLUDED
+#define _parallel_hpp_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Data structures of the parallel portfolio solver 'ParallelSolver'
+// declared in 'cadical.hpp' and implemented in 'parallel.cpp', including
+// the cube-and-conquer mode of 'ParallelSolver::conquer'.
+
+class Solver;
+struct Portfolio;
+
+/*------------------------------------------------------------------------*/
+
+// Lock-free single producer single consumer ring buffer of clauses.  The
+// clauses are stored in the batch format of 'LearnSource::getNextClauses',
+// i.e., glue, literals and a terminating zero (glue '0' for units).  The
+// two positions only grow and are mapped to the buffer with 'mask'.  If
+// the buffer is full the producer drops the clause instead of waiting.
+
+class ClauseRing {
+
+  std::vector<int> buffer;
+  const uint64_t mask;
+
+  std::atomic<uint64_t> written;        // Only changed by producer.
+  std::atomic<uint64_t> read;           // Only changed by consumer.
+
+public:
+
+  ClauseRing (unsigned log2size);
+
+  bool push (const int * begin, const int * end);       // Producer.
+
+  bool empty () const;                                  // Consumer.
+  void pop (std::vector<int> & clause);                 // Single.
+  void pop_all (std::vector<int> & batch);              // Batch.
+};
+
+/*------------------------------------------------------------------------*/
+
+// A cube to be solved under assumptions with the given conflict limit.
+
+struct Cube {
+  std::vector<int> lits;
+  int64_t limit;
+};
+
+// Each worker has its own queue of cubes.  The owner pushes and pops cubes
+// at the back (depth first for split cubes) while idle workers steal from
+// the front, which holds the oldest and thus usually largest sub-trees.
+// Cubes are only moved a few times per conflict limit, thus a lock per
+// queue is good enough.
+
+class CubeQueue {
+
+  std::mutex lock;
+  std::deque<Cube> cubes;
+
+public:
+
+  void push (Cube &);                                   // Owner.
+  bool pop (Cube &);                                    // Owner.
+  bool steal (Cube &);                                  // Others.
+  void clear ();
+};
+
+/*------------------------------------------------------------------------*/
+
+// A worker exports its learned clauses to all other workers, imports the
+// clauses of the other workers before decisions and checks whether another
+// worker already finished, all through the call-back interfaces.
+
+struct Worker : public BatchLearner, public LearnSource, public Terminator {
+
+  Portfolio * portfolio;
+  Solver * solver;
+  int id;
+
+  std::vector<ClauseRing *> out;        // Rings to other workers.
+  std::vector<ClauseRing *> in;         // Rings from other workers.
+
+  std::vector<int> importing;           // Last imported single clause.
+  std::vector<int> batch;               // Last imported batch.
+
+  CubeQueue cubes;                      // Own cubes in 'conquer'.
+  size_t refuted;                       // Imported refuted cubes.
+
+  struct {
+    int64_t exported, dropped;
+    int64_t conquered, split, stolen;
+  } stats;
+
+  int res;                              // Result of last 'solve'.
+
+  Worker (Portfolio *, Solver *, int id);
+
+  void learn (const int * begin, const int * end);
+
+  bool hasNextClause ();
+  const std::vector<int> & getNextClause ();
+  bool getNextClauses (const int *& begin, const int *& end);
+
+  bool terminate ();
+
+  void finish (int res);
+  void run ();
+
+  bool next_cube (Cube &);
+  void import_refuted ();
+  void refute (const Cube &);
+  void split (Cube &);
+  void conquer ();
+};
+
+/*------------------------------------------------------------------------*/
+
+struct Portfolio {
+
+  std::vector<Worker *> workers;
+  std::vector<ClauseRing *> rings;      // All 'threads * (threads-1)'.
+
+  std::atomic<bool> done;               // Some worker finished.
+  std::atomic<int> winner;              // First finished worker or '-1'.
+
+  Terminator * terminator;              // Checked by first worker.
+  bool connected;                       // Call-backs connected.
+
+  // Cube-and-conquer state.  The number of 'pending' cubes counts queued
+  // cubes and cubes being solved.  If it drops to zero all cubes were
+  // refuted.  Refuted cubes are turned into clauses of negated failed
+  // assumptions, each terminated by zero, which all workers add before
+  // solving their next cube.
+
+  std::atomic<int64_t> pending;
+  std::mutex refuted_lock;
+  std::vector<int> refuted;
+
+  // Workers without cubes sleep on 'idle' until new cubes are pushed or
+  // some worker finished, which is signalled by incrementing 'wakeups'.
+
+  std::mutex idle_lock;
+  std::condition_variable idle;
+  std::atomic<uint64_t> wakeups;
+
+  void wake ();
+  void wait (uint64_t wakeups);
+
+  Portfolio () :
+    done (false), winner (-1), terminator (0), connected (false),
+    pending (0), wakeups (0) { }
+};
+
+}
+
+#endif
@@ -1,5 +1,9 @@
 #include "internal.hpp"
 
+#ifndef NTHREADS
+#include <thread>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 namespace CaDiCaL {
@@ -58,7 +62,18 @@ Parser::parse_lit (int & ch, int & lit, int & vars, int strict) {
   } else if (!isdigit (ch)) PER ("expected digit or '-'");
   else sign = 1;
   lit = ch - '0';
-  while (isdigit (ch = parse_char ())) {
+  unsigned rest;
+  const int n = file->digits (rest);
+  if (n >= 0) {
+    static const int64_t pow10[10] = {
+      1, 10, 100, 1000, (int) 1e4, (int) 1e5, (int) 1e6, (int) 1e7,
+      (int) 1e8, (int) 1e9
+    };
+    const int64_t res = lit * pow10[n] + rest;
+    if (res > INT_MAX) PER ("literal too large");
+    lit = res;
+    ch = parse_char ();
+  } else while (isdigit (ch = parse_char ())) {
     int digit = ch - '0';
     if (INT_MAX/10 < lit || INT_MAX - digit < 10*lit)
       PER ("literal too large");
@@ -78,6 +93,151 @@ Parser::parse_lit (int & ch, int & lit, int & vars, int strict) {
 
 /*------------------------------------------------------------------------*/
 
+// For large memory mapped files the body of a DIMACS file can be parsed in
+// parallel ('--parsethreads').  The rest of the file after the header is
+// split into chunks at new-lines.  Each chunk is parsed by its own thread
+// into a zero terminated sequence of literals, which are then added in
+// order.  Clauses spanning several lines might end up in two chunks, but
+// this does not matter since the literals are concatenated anyway.
+//
+// The chunk parser is deliberately conservative.  It only accepts exactly
+// what the sequential parser would accept and otherwise just fails, in
+// which case we fall back to the sequential parser, which then produces
+// the proper parse error with line number.  Literals exceeding the maximum
+// variable of the header and wrong clause counts are treated the same.
+
+#ifndef NTHREADS
+
+struct ParseChunk {
+  const char * begin, * end;    // part of the mapped file
+  vector<int> lits;             // parsed zero terminated clauses
+  int64_t clauses;              // number of zeros in 'lits'
+  uint64_t lines;               // number of new-lines in chunk
+  int vars;                     // maximum variable
+  bool failed;                  // fall back to sequential parser
+  ParseChunk (const char * b, const char * e) :
+    begin (b), end (e), clauses (0), lines (0), vars (0), failed (false)
+  { }
+};
+
+static void parse_chunk (ParseChunk * chunk, int vars, bool forced) {
+  const char * p = chunk->begin, * end = chunk->end;
+  chunk->lits.reserve ((end - p) / 4);
+  while (p != end) {
+    int ch = (unsigned char) *p++;
+    if (ch == ' ' || ch == '\t' || ch == '\r') continue;
+    if (ch == '\n') { chunk->lines++; continue; }
+    if (ch == 'c') {
+      while (p != end && *p != '\n') p++;
+      continue;
+    }
+    int sign = 1;
+    if (ch == '-') {
+      if (p == end || !isdigit ((unsigned char) *p)) {
+        chunk->failed = true;
+        return;
+      }
+      ch = *p++;
+      sign = -1;
+    } else if (!isdigit (ch)) { chunk->failed = true; return; }
+    int64_t lit = ch - '0';
+    while (p != end && isdigit ((unsigned char) *p)) {
+      lit = 10*lit + (*p++ - '0');
+      if (lit > INT_MAX) { chunk->failed = true; return; }
+    }
+    if (p != end && *p == '\r') p++;
+    if (p != end) {
+      ch = *p++;
+      if (ch == '\n') chunk->lines++;
+      else if (ch == 'c') {
+        while (p != end && *p != '\n') p++;
+        if (p == end) { chunk->failed = true; return; }
+      } else if (ch != ' ' && ch != '\t') { chunk->failed = true; return; }
+    }
+    if (lit > vars) {
+      if (!forced) { chunk->failed = true; return; }
+      if (lit > chunk->vars) chunk->vars = lit;
+    }
+    if (!lit) chunk->clauses++;
+    chunk->lits.push_back (sign * (int) lit);
+  }
+}
+
+#endif
+
+// Returns 'true' if the whole body was parsed and added.  Otherwise
+// nothing was read nor added and the sequential parser takes over.
+
+bool Parser::parse_dimacs_in_parallel (int & vars, int strict,
+                                       int clauses, int & parsed) {
+#ifdef NTHREADS
+  (void) vars, (void) strict, (void) clauses, (void) parsed;
+  return false;
+#else
+  const int threads = internal->opts.parsethreads;
+  if (threads < 2) return false;
+  const char * begin = file->mapped_begin ();
+  const char * end = file->mapped_end ();
+  const size_t min_chunk_size = 1u << 20;
+  if ((size_t) (end - begin) < 2 * min_chunk_size) return false;
+  size_t chunks = (end - begin) / min_chunk_size;
+  if (chunks > (size_t) threads) chunks = threads;
+
+  vector<ParseChunk> parts;
+  const char * p = begin;
+  for (size_t i = 1; p != end && i <= chunks; i++) {
+    const char * q = end;
+    if (i < chunks) {
+      q = begin + i * (size_t) (end - begin) / chunks;
+      if (q < p) q = p;
+      q = (const char *) memchr (q, '\n', end - q);
+      q = q ? q + 1 : end;
+    }
+    parts.push_back (ParseChunk (p, q));
+    p = q;
+  }
+  assert (p == end);
+
+  const bool forced = (strict == FORCED);
+  vector<std::thread> running;
+  for (auto & part : parts)
+    running.push_back (std::thread (parse_chunk, &part, vars, forced));
+  for (auto & thread : running)
+    thread.join ();
+
+  int64_t total = 0;
+  int max_var = vars;
+  for (const auto & part : parts) {
+    if (part.failed) return false;
+    total += part.clauses;
+    if (part.vars > max_var) max_var = part.vars;
+  }
+  for (auto i = parts.rbegin (); i != parts.rend (); i++) {
+    if (i->lits.empty ()) continue;
+    if (i->lits.back ()) return false;   // last clause without '0'
+    break;
+  }
+  if (!forced && total != clauses) return false;
+
+  PHASE ("parse-dimacs",
+    "parsed %zd chunks with %" PRId64 " clauses in parallel",
+    parts.size (), total);
+
+  uint64_t lines = 0;
+  for (auto & part : parts) {
+    solver->add_clauses (part.lits);
+    erase_vector (part.lits);
+    lines += part.lines;
+  }
+  file->skip (lines);
+  vars = max_var;
+  parsed = total;
+  return true;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
 // Parsing CNF in DIMACS format.
 
 const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
@@ -202,7 +362,10 @@ const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
   // Now read body of DIMACS part.
   //
   int lit = 0, parsed = 0;
-  while ((ch = parse_char ()) != EOF) {
+  if (!found_inccnf_header &&
+      parse_dimacs_in_parallel (vars, strict, clauses, parsed))
+    ch = EOF;
+  else while ((ch = parse_char ()) != EOF) {
     if (ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r') continue;
     if (ch == 'c') {
       while ((ch = parse_char ()) != '\n' && ch != EOF)
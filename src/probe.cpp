@@ -1,4 +1,5 @@
 #include "internal.hpp"
+#include "propagate.hpp"
 
 namespace CaDiCaL {
 
@@ -105,10 +106,9 @@ int Internal::probe_dominator (int a, int b) {
 
 // Finally note that adding clauses changes the watches of the propagated
 // literal and thus we can not use standard iterators during probing but
-// need to fall back to indices.  One watch for the hyper binary resolvent
-// clause is added at the end of the currently propagated watches, but its
-// watch is a binary watch and will be skipped during propagating long
-// clauses anyhow.
+// need to fall back to indices.  The watches for the hyper binary resolvent
+// clause are added to the binary watch lists though and thus do not
+// interfere with propagating long clauses.
 
 inline int Internal::hyper_binary_resolve (Clause * reason) {
   require_mode (PROBE);
@@ -225,19 +225,42 @@ void Internal::probe_assign_unit (int lit) {
 // perform hyper binary resolution and thus actually build an implication
 // tree instead of a DAG.  Statistics counters are also different.
 
+// Probing propagation policy for 'propagate_watches' and
+// 'propagate_binary_watches' (see 'propagate.hpp').
+
+struct ProbePropagation {
+
+  static const bool simd = false;
+  static const bool ignore = false;
+  static const bool ternary = false;    // needs 'hyper_binary_resolve'
+
+  Internal * internal;
+
+  ProbePropagation (Internal * i) : internal (i) { }
+
+  bool vectorize () const { return false; }
+
+  void assign (int lit, Clause *, int parent) {
+    internal->probe_assign (lit, parent);
+  }
+
+  bool assign (int lit, Clause * c) {
+    if (internal->level == 1) {
+      int dom = internal->hyper_binary_resolve (c);
+      internal->probe_assign (lit, dom);
+    } else internal->probe_assign_unit (lit);
+    internal->probe_propagate2 ();
+    return false;
+  }
+};
+
 inline void Internal::probe_propagate2 () {
   require_mode (PROBE);
+  ProbePropagation policy (this);
   while (propagated2 != trail.size ()) {
     const int lit = -trail[propagated2++];
     LOG ("probe propagating %d over binary clauses", -lit);
-    Watches & ws = watches (lit);
-    for (const auto & w : ws) {
-      if (!w.binary ()) continue;
-      const signed char b = val (w.blit);
-      if (b > 0) continue;
-      if (b < 0) conflict = w.clause;                   // but continue
-      else probe_assign (w.blit, -lit);
-    }
+    propagate_binary_watches (policy, lit);
   }
 }
 
@@ -245,65 +268,14 @@ bool Internal::probe_propagate () {
   require_mode (PROBE);
   assert (!unsat);
   START (propagate);
+  ProbePropagation policy (this);
   int64_t before = propagated2 = propagated;
   while (!conflict) {
     if (propagated2 != trail.size ()) probe_propagate2 ();
     else if (propagated != trail.size ()) {
       const int lit = -trail[propagated++];
       LOG ("probe propagating %d over large clauses", -lit);
-      Watches & ws = watches (lit);
-      size_t i = 0, j = 0;
-      while (i != ws.size ()) {
-        const Watch w = ws[j++] = ws[i++];
-        if (w.binary ()) continue;
-        const signed char b = val (w.blit);
-        if (b > 0) continue;
-        if (w.clause->garbage) continue;
-        const literal_iterator lits = w.clause->begin ();
-        const int other = lits[0]^lits[1]^lit;
-        //lits[0] = other, lits[1] = lit;
-        const signed char u = val (other);
-        if (u > 0) ws[j-1].blit = other;
-        else {
-          const int size = w.clause->size;
-          const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
-          literal_iterator k = middle;
-          int r = 0;
-          signed char v = -1;
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
-          if (v < 0) {
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
-          }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
-          if (v > 0) ws[j-1].blit = r;
-          else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
-            *k = lit;
-            lits[0] = other;
-            lits[1] = r;
-            watch_literal (r, lit, w.clause);
-            j--;
-          } else if (!u) {
-            if (level == 1) {
-              lits[0] = other, lits[1] = lit;
-              int dom = hyper_binary_resolve (w.clause);
-              probe_assign (other, dom);
-            } else probe_assign_unit (other);
-            probe_propagate2 ();
-          } else conflict = w.clause;
-        }
-      }
-      if (j != i) {
-        while (i != ws.size ())
-          ws[j++] = ws[i++];
-        ws.resize (j);
-      }
+      propagate_watches (policy, lit);
     } else break;
   }
   int64_t delta = propagated2 - before;
@@ -604,7 +576,7 @@ bool Internal::probe_round () {
     if (!propagate ()) {
       LOG ("propagating units after probing results in empty clause");
       learn_empty_clause ();
-    } else sort_watches ();
+    }
   }
 
   int failed = stats.failed - old_failed;
@@ -635,6 +607,8 @@ void CaDiCaL::Internal::probe (bool update_limits) {
   if (level) backtrack ();
   if (!propagate ()) { learn_empty_clause (); return; }
 
+  check_memory_limit ();
+
   stats.probingphases++;
 
   const int before = active ();
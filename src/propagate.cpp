@@ -1,4 +1,5 @@
 #include "internal.hpp"
+#include "propagate.hpp"
 
 namespace CaDiCaL {
 
@@ -83,6 +84,11 @@ inline void Internal::search_assign (int lit, Clause * reason) {
 #endif
 
   if (watching ()) {
+    const Watches & bs = binary_watches (-lit);
+    if (!bs.empty ()) {
+      const Watch & w = bs[0];
+      __builtin_prefetch (&w, 0, 1);
+    }
     const Watches & ws = watches (-lit);
     if (!ws.empty ()) {
       const Watch & w = ws[0];
@@ -131,222 +137,190 @@ void Internal::search_assign_driving (int lit, Clause * c) {
 // This version of 'propagate' uses lazy watches and keeps two watched
 // literals at the beginning of the clause.  We also use 'blocking literals'
 // to reduce the number of times clauses have to be visited (2008 JSAT paper
-// by Chu, Harwood and Stuckey).  The watches know if a watched clause is
-// binary, in which case it never has to be visited.  If a binary clause is
-// falsified we continue propagating.
+// by Chu, Harwood and Stuckey).  Binary clauses are watched in separate
+// watch lists and never have to be visited.  They are propagated eagerly
+// over the whole trail before any long clause watch is traversed, thus
+// using 'propagated2' as separate binary propagation pointer (similar to
+// 'probe_propagate').  If a binary clause is falsified we continue
+// propagating binary clauses but stop before visiting long clauses.
 
 // Finally, for long clauses we save the position of the last watch
 // replacement in 'pos', which in turn reduces certain quadratic accumulated
-// propagation costs (2013 JAIR article by Ian Gent) at the expense of four
-// more bytes for each clause.
-
-bool Internal::propagate () {
-
-  if (level) require_mode (SEARCH);
-  assert (!unsat);
-
-  START (propagate);
-
-  // Updating statistics counter in the propagation loops is costly so we
-  // delay until propagation ran to completion.
-  //
-  int64_t before = propagated;
-
-  while (!conflict && propagated != trail.size ()) {
-
-    const int lit = -trail[propagated++];
-    LOG ("propagating %d", -lit);
-    Watches & ws = watches (lit);
-
-    const const_watch_iterator eow = ws.end ();
-    watch_iterator j = ws.begin ();
-    const_watch_iterator i = j;
-
-    while (i != eow) {
-
-      const Watch w = *j++ = *i++;
-      const signed char b = val (w.blit);
-
-      if (b > 0) continue;                // blocking literal satisfied
-
-      if (w.binary ()) {
-
-        // In principle we can ignore garbage binary clauses too, but that
-        // would require to dereference the clause pointer all the time with
-        //
-        // if (w.clause->garbage) { j--; continue; } // (*)
-        //
-        // This is too costly.  It is however necessary to produce correct
-        // proof traces if binary clauses are traced to be deleted ('d ...'
-        // line) immediately as soon they are marked as garbage.  Actually
-        // finding instances where this happens is pretty difficult (six
-        // parallel fuzzing jobs in parallel took an hour), but it does
-        // occur.  Our strategy to avoid generating incorrect proofs now is
-        // to delay tracing the deletion of binary clauses marked as garbage
-        // until they are really deleted from memory.  For large clauses
-        // this is not necessary since we have to access the clause anyhow.
-        //
-        // Thanks go to Mathias Fleury, who wanted me to explain why the
-        // line '(*)' above was in the code. Removing it actually really
-        // improved running times and thus I tried to find concrete
-        // instances where this happens (which I found), and then
-        // implemented the described fix.
-
-        // Binary clauses are treated separately since they do not require
-        // to access the clause at all (only during conflict analysis, and
-        // there also only to simplify the code).
-
-        if (b < 0) conflict = w.clause;          // but continue ...
-        else search_assign (w.blit, w.clause);
-
-      } else {
-
-        if (conflict) break; // Stop if there was a binary conflict already.
-
-        // The cache line with the clause data is forced to be loaded here
-        // and thus this first memory access below is the real hot-spot of
-        // the solver.  Note, that this check is positive very rarely and
-        // thus branch prediction should be almost perfect here.
-
-        if (w.clause->garbage) { j--; continue; }
-
-        literal_iterator lits = w.clause->begin ();
-
-        // Simplify code by forcing 'lit' to be the second literal in the
-        // clause.  This goes back to MiniSAT.  We use a branch-less version
-        // for conditionally swapping the first two literals, since it
-        // turned out to be substantially faster than this one
-        //
-        //  if (lits[0] == lit) swap (lits[0], lits[1]);
-        //
-        // which achieves the same effect, but needs a branch.
-        //
-        const int other = lits[0] ^ lits[1] ^ lit;
-        const signed char u = val (other); // value of the other watch
-
-        if (u > 0) j[-1].blit = other; // satisfied, just replace blit
-        else {
+// propagation costs (2013 JAIR article by Ian Gent).  It is stored after
+// the last literal and only for clauses with at least 'min_pos_size'
+// literals (see 'clause.hpp'), where it costs four more bytes.  For shorter
+// clauses the search always starts at the first non-watched literal.
 
-          // This follows Ian Gent's (JAIR'13) idea of saving the position
-          // of the last watch replacement.  In essence it needs two copies
-          // of the default search for a watch replacement (in essence the
-          // code in the 'if (v < 0) { ... }' block below), one starting at
-          // the saved position until the end of the clause and then if that
-          // one failed to find a replacement another one starting at the
-          // first non-watched literal until the saved position.
-
-          const int size = w.clause->size;
-          const literal_iterator middle = lits + w.clause->pos;
-          const const_literal_iterator end = lits + size;
-          literal_iterator k = middle;
-
-          // Find replacement watch 'r' at position 'k' with value 'v'.
+/*------------------------------------------------------------------------*/
 
-          int r = 0;
-          signed char v = -1;
+// Replay the saved trail (see 'backtrack.cpp') in order.  An implied saved
+// literal can be assigned directly without visiting any watch if all other
+// literals in its reason are false again.  This is checked on the reason
+// itself, since the saved literal is not necessarily watched (the inline
+// ternary clause path in 'propagate.hpp' assigns the third literal without
+// moving it).  Saved literals which are already true and saved decisions
+// are skipped, since after backjumping the first saved literal usually is
+// the decision of the undone level, which is not made again immediately,
+// while later saved literals might still become implied.  If the reason of
+// the next saved literal is not unit yet we stop but keep the rest, since
+// further propagation might make it unit.  If the saved literal is false
+// but its reason unit, the reason is falsified, which gives a conflict
+// (which 'analyze' can only handle with chronological backtracking, since
+// its literals might all be on lower levels).
+
+inline void Internal::replay_saved_trail () {
+  assert (!conflict);
+  const size_t size = saved_trail.size ();
+  while (saved_replayed < size) {
+    const Saved & saved = saved_trail[saved_replayed];
+    const int lit = saved.lit;
+    const signed char tmp = val (lit);
+    Clause * reason = saved.reason;
+    if (tmp > 0 || !reason || reason->garbage) { saved_replayed++; continue; }
+    bool unit = true;
+    for (const auto & other : *reason)
+      if (other != lit && val (other) >= 0) { unit = false; break; }
+    if (!unit) break;
+    if (tmp < 0) {
+      if (opts.chrono) {
+        LOG (reason, "saved trail conflict");
+        stats.trailsave.conflicts++;
+        conflict = reason;
+      }
+      clear_saved_trail ();
+      break;
+    }
+    search_assign (lit, reason);
+    stats.trailsave.replayed++;
+    saved_replayed++;
+  }
+}
 
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
+// With 'opts.chrono > 1' the search propagation policy below is
+// instantiated with 'rewatch' set, which calls this function after a unit
+// 'lits[0]' was found in a long clause 'c' while propagating 'lit'.
 
-          if (v < 0) {  // need second search starting at the head?
+// Similar code is in the implementation of the SAT'18 paper on
+// chronological backtracking but in our experience, this code first does
+// not really seem to be necessary for correctness, and further does not
+// improve running time either.
 
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
-          }
+inline bool Internal::search_rewatch (int lit, Clause * c) {
 
-          w.clause->pos = k - lits;  // always save position
+  const literal_iterator lits = c->begin ();
+  const int other = lits[0];
+  assert (lits[1] == lit);
 
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+  const int other_level = var (other).level;
 
-          if (v > 0) {
+  if (other_level <= var (lit).level) return false;
 
-            // Replacement satisfied, so just replace 'blit'.
+  // The assignment level of the new unit 'other' is larger than the
+  // assignment level of 'lit'.  Thus we should find another literal in
+  // the clause at that higher assignment level and watch that instead of
+  // 'lit'.
 
-            j[-1].blit = r;
+  const int size = c->size;
+  assert (size > 2);
 
-          } else if (!v) {
+  int pos, s = 0;
 
-            // Found new unassigned replacement literal to be watched.
+  for (pos = 2; pos < size; pos++)
+    if (var (s = lits[pos]).level == other_level)
+      break;
 
-            LOG (w.clause, "unwatch %d in", lit);
+  assert (s);
+  assert (pos < size);
 
-            lits[0] = other;
-            lits[1] = r;
-            *k = lit;
+  LOG (c, "unwatch %d in", lit);
+  lits[pos] = lit;
+  lits[0] = other;
+  lits[1] = s;
+  watch_literal (s, other, c);
 
-            watch_literal (r, lit, w.clause);
+  return true;  // Drop this watch from the watch list of 'lit'.
+}
 
-            j--;  // Drop this watch from the watch list of 'lit'.
+template<bool rewatch>
+struct SearchPropagation {
 
-          } else if (!u) {
+  static const bool simd = true;
+  static const bool ignore = false;
+  static const bool ternary = !rewatch;
 
-            assert (v < 0);
+  Internal * internal;
+  bool vectorized;
 
-            // The other watch is unassigned ('!u') and all other literals
-            // assigned to false (still 'v < 0'), thus we found a unit.
-            //
-            search_assign (other, w.clause);
+  SearchPropagation (Internal * i) : internal (i) {
+#ifdef SIMD_BLITS
+    vectorized = i->opts.simd && simd_blits_supported ();
+#else
+    vectorized = false;
+#endif
+  }
 
-            // Similar code is in the implementation of the SAT'18 paper on
-            // chronological backtracking but in our experience, this code
-            // first does not really seem to be necessary for correctness,
-            // and further does not improve running time either.
-            //
-            if (opts.chrono > 1) {
+  bool vectorize () const { return vectorized; }
 
-              const int other_level = var (other).level;
+  void assign (int lit, Clause * c, int) {
+    internal->search_assign (lit, c);
+  }
 
-              if (other_level > var (lit).level) {
+  bool assign (int lit, Clause * c) {
+    internal->search_assign (lit, c);
+    if (!rewatch) return false;
+    const int propagated = c->literals[1];
+    return internal->search_rewatch (propagated, c);
+  }
+};
 
-                // The assignment level of the new unit 'other' is larger
-                // than the assignment level of 'lit'.  Thus we should find
-                // another literal in the clause at that higher assignment
-                // level and watch that instead of 'lit'.
+/*------------------------------------------------------------------------*/
 
-                assert (size > 2);
+template<class P>
+inline void Internal::search_propagate (P & policy) {
 
-                int pos, s = 0;
+  while (!conflict) {
 
-                for (pos = 2; pos < size; pos++)
-                  if (var (s = lits[pos]).level == other_level)
-                    break;
+    if (propagated2 != trail.size ()) {
 
-                assert (s);
-                assert (pos < size);
+      const int lit = -trail[propagated2++];
+      LOG ("propagating %d over binary clauses", -lit);
+      propagate_binary_watches (policy, lit);
+      continue;
+    }
 
-                LOG (w.clause, "unwatch %d in", lit);
-                lits[pos] = lit;
-                lits[0] = other;
-                lits[1] = s;
-                watch_literal (s, other, w.clause);
+    if (saved_replayed != saved_trail.size () &&
+        !searching_lucky_phases) {
+      replay_saved_trail ();
+      if (conflict) break;
+      if (propagated2 != trail.size ()) continue;
+    }
 
-                j--;  // Drop this watch from the watch list of 'lit'.
-              }
-            }
-          } else {
+    if (propagated == trail.size ()) break;
 
-            assert (u < 0);
-            assert (v < 0);
+    const int lit = -trail[propagated++];
+    LOG ("propagating %d over large clauses", -lit);
+    propagate_watches (policy, lit);
+  }
+}
 
-            // The other watch is assigned false ('u < 0') and all other
-            // literals as well (still 'v < 0'), thus we found a conflict.
+bool Internal::propagate () {
 
-            conflict = w.clause;
-            break;
-          }
-        }
-      }
-    }
+  if (level) require_mode (SEARCH);
+  assert (!unsat);
 
-    if (j != i) {
+  START (propagate);
 
-      while (i != eow)
-        *j++ = *i++;
+  // Updating statistics counter in the propagation loops is costly so we
+  // delay until propagation ran to completion.
+  //
+  int64_t before = propagated2 = propagated;
 
-      ws.resize (j - ws.begin ());
-    }
+  if (opts.chrono > 1) {
+    SearchPropagation<true> policy (this);
+    search_propagate (policy);
+  } else {
+    SearchPropagation<false> policy (this);
+    search_propagate (policy);
   }
 
   if (searching_lucky_phases) {
@@ -358,7 +332,7 @@ bool Internal::propagate () {
 
     // Avoid updating stats eagerly in the hot-spot of the solver.
     //
-    stats.propagations.search += propagated - before;
+    stats.propagations.search += propagated2 - before;
 
     if (!conflict) no_conflict_until = propagated;
     else {
@@ -0,0 +1,325 @@
+#ifndef _propagate_hpp_INCLUDED
+#define _propagate_hpp_INCLUDED
+
+// Vectorized scanning of blocking literals in 'propagate' needs gather
+// instructions which are only available with AVX2.  The code is compiled
+// for AVX2 only in the function using it and selected at run-time if the
+// processor supports it and 'opts.simd' is set, which is disabled by
+// default since it did not give a speed-up in our measurements.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_BLITS
+#include <immintrin.h>
+#endif
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// The propagation loops over binary and long clause watches are shared by
+// search ('propagate.cpp'), probing ('probe.cpp'), vivification
+// ('vivify.cpp') and instantiation ('instantiate.cpp').  They are
+// templates specialized at compile time on a propagation policy 'P',
+// which provides the following members:
+//
+//   static const bool simd;      // try vectorized blocking literal scan
+//   static const bool ignore;    // skip the 'ignore' clause
+//   static const bool ternary;   // propagate inline ternary watches
+//   bool vectorize () const;     // actually use vectorized scan
+//   void assign (int lit, Clause * c, int parent);   // binary unit
+//   bool assign (int lit, Clause * c);  // long unit (true = drop watch)
+//
+// The first 'assign' is called for units in binary clauses and inline
+// ternary watches (if 'P::ternary' is set), where 'parent' is the negation
+// of the propagated literal.  The second 'assign' is called for units
+// found in other long clauses with 'lit' already at 'c->literals[0]' and
+// the propagated literal at 'c->literals[1]'.  Otherwise the policies are
+// plain structs with a pointer to 'internal' and all calls are inlined.
+
+/*------------------------------------------------------------------------*/
+
+// Most watches visited in 'propagate' have a satisfied blocking literal
+// and thus do not require to access the clause.  On long watch lists it
+// pays off to check the values of the blocking literals of eight watches at
+// once.  First the blocking literals are gathered from the watches and
+// then their values from 'vals' (four bytes each, thus 'vals' is padded
+// by 'sizeof (int)' bytes at the end, see 'enlarge_vals').  The result is
+// the number of consecutive watches starting at 'begin' with satisfied
+// blocking literal, where the last incomplete block is not scanned.
+
+#ifdef SIMD_BLITS
+
+__attribute__ ((target ("avx2")))
+static inline size_t satisfied_blits (const signed char * vals,
+                                      const Watch * begin,
+                                      const Watch * end)
+{
+  const int stride = sizeof (Watch) / sizeof (int);
+  const int offset = (const int *) &begin->blit - (const int *) begin;
+  const __m256i indices =
+    _mm256_add_epi32 (_mm256_set1_epi32 (offset),
+      _mm256_mullo_epi32 (_mm256_set1_epi32 (stride),
+                          _mm256_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7)));
+  const __m256i zero = _mm256_setzero_si256 ();
+  const Watch * p = begin;
+  while (end - p >= 8) {
+    const __m256i blits =
+      _mm256_i32gather_epi32 ((const int *) p, indices, 4);
+    __m256i values =
+      _mm256_i32gather_epi32 ((const int *) vals, blits, 1);
+    values = _mm256_slli_epi32 (values, 24);    // keep only 'vals[blit]'
+    const __m256i satisfied = _mm256_cmpgt_epi32 (values, zero);
+    const unsigned mask =
+      _mm256_movemask_ps (_mm256_castsi256_ps (satisfied));
+    if (mask != 0xff) return (p - begin) + __builtin_ctz (~mask);
+    p += 8;
+  }
+  return p - begin;
+}
+
+// Thread-safe, since portfolio workers start propagating concurrently.
+
+static inline bool simd_blits_supported () {
+  static const bool res =
+    (__builtin_cpu_init (), __builtin_cpu_supports ("avx2"));
+  return res;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Propagate 'lit' assigned to false over binary clauses.  In principle we
+// can ignore garbage binary clauses too, but that would require to
+// dereference the clause pointer all the time with
+//
+// if (watched_clause (w)->garbage) continue; // (*)
+//
+// This is too costly.  It is however necessary to produce correct proof
+// traces if binary clauses are traced to be deleted ('d ...' line)
+// immediately as soon they are marked as garbage.  Actually finding
+// instances where this happens is pretty difficult (six parallel fuzzing
+// jobs in parallel took an hour), but it does occur.  Our strategy to avoid
+// generating incorrect proofs now is to delay tracing the deletion of
+// binary clauses marked as garbage until they are really deleted from
+// memory.  For large clauses this is not necessary since we have to access
+// the clause anyhow.
+//
+// Thanks go to Mathias Fleury, who wanted me to explain why the line '(*)'
+// above was in the code. Removing it actually really improved running
+// times and thus I tried to find concrete instances where this happens
+// (which I found), and then implemented the described fix.
+//
+// Binary clauses are treated separately since they do not require to
+// access the clause at all (only during conflict analysis, and there also
+// only to simplify the code).  A conflict does not stop this loop.
+
+template<class P>
+inline void Internal::propagate_binary_watches (P & policy, int lit) {
+
+  const Watches & bs = binary_watches (lit);
+
+  for (const auto & w : bs) {
+    assert (w.binary ());
+    const signed char b = val (w.blit);
+    if (b > 0) continue;                // other literal satisfied
+    if (b < 0) conflict = watched_clause (w);   // but continue ...
+    else policy.assign (w.blit, watched_clause (w), -lit);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Propagate 'lit' assigned to false over long clauses.  This version uses
+// lazy watches and keeps two watched literals at the beginning of the
+// clause.  We also use 'blocking literals' to reduce the number of times
+// clauses have to be visited (2008 JSAT paper by Chu, Harwood and
+// Stuckey).  The position of the last watch replacement is saved in
+// 'pos', which in turn reduces certain quadratic accumulated propagation
+// costs (2013 JAIR article by Ian Gent).  Stops at the first conflict.
+
+template<class P>
+inline void Internal::propagate_watches (P & policy, int lit) {
+
+  Watches & ws = watches (lit);
+
+  const const_watch_iterator eow = ws.end ();
+  watch_iterator j = ws.begin ();
+  const_watch_iterator i = j;
+
+#ifdef SIMD_BLITS
+  const bool simd = P::simd && policy.vectorize ();
+  unsigned run = 0;     // satisfied blocking literals in a row
+#endif
+
+  while (i != eow) {
+
+#ifdef SIMD_BLITS
+    // Only switch to the vectorized scan after a run of satisfied blocking
+    // literals, since it does not pay off if many of the scanned watches
+    // are not satisfied.
+    //
+    if (P::simd && run >= 2 && eow - i >= 8) {
+      const size_t n = satisfied_blits (vals, i, eow);
+      if (n) {
+        if (j != i) memmove (j, i, n * sizeof (Watch));
+        i += n, j += n;
+        if (i == eow) break;
+      }
+      run = 0;
+    }
+#endif
+
+    const Watch w = *j++ = *i++;
+    const signed char b = val (w.blit);
+
+    if (b > 0) {                        // blocking literal satisfied
+#ifdef SIMD_BLITS
+      if (P::simd) run += simd;
+#endif
+      continue;
+    }
+
+#ifdef SIMD_BLITS
+    if (P::simd) run = 0;
+#endif
+
+    assert (!w.binary ());
+    Clause * c = watched_clause (w);
+
+#ifndef WATCH32
+    // Ternary clauses with both other literals inline (see 'watch.hpp').
+    // If one of them is unassigned and the other one false, the clause is
+    // unit and we do not move the watch.  The assignment level of the unit
+    // is at least as large as the level of one of the watched literals,
+    // which in turn are both false.  Thus backtracking can not produce a
+    // unit ternary clause which is not watched by the unit literal.
+    //
+    if (P::ternary && w.ternary ()) {
+      if (P::ignore && c == ignore) continue;
+      const signed char t = val (w.third);
+      if (t > 0) { j[-1].update_blit (w.third); continue; }
+      if (t < 0) {
+        if (b < 0) { conflict = c; break; }
+        policy.assign (w.blit, c, -lit);
+        continue;
+      }
+      if (b < 0) {
+        policy.assign (w.third, c, -lit);
+        continue;
+      }
+    }
+#endif
+
+    // The cache line with the clause data is forced to be loaded here
+    // and thus this first memory access below is the real hot-spot of
+    // the solver.  Note, that this check is positive very rarely and
+    // thus branch prediction should be almost perfect here.
+
+    if (c->garbage) { j--; continue; }
+    if (P::ignore && c == ignore) continue;
+
+    literal_iterator lits = c->begin ();
+
+    // Simplify code by forcing 'lit' to be the second literal in the
+    // clause.  This goes back to MiniSAT.  We use a branch-less version
+    // for conditionally swapping the first two literals, since it
+    // turned out to be substantially faster than this one
+    //
+    //  if (lits[0] == lit) swap (lits[0], lits[1]);
+    //
+    // which achieves the same effect, but needs a branch.
+    //
+    const int other = lits[0] ^ lits[1] ^ lit;
+    const signed char u = val (other); // value of the other watch
+
+    if (u > 0) { j[-1].update_blit (other); continue; }  // replace blit
+
+    // This follows Ian Gent's (JAIR'13) idea of saving the position of
+    // the last watch replacement.  In essence it needs two copies of the
+    // default search for a watch replacement (in essence the code in the
+    // 'if (v < 0) { ... }' block below), one starting at the saved
+    // position until the end of the clause and then if that one failed
+    // to find a replacement another one starting at the first
+    // non-watched literal until the saved position.
+
+    const int size = c->size;
+    const literal_iterator middle = lits + c->saved_pos ();
+    const const_literal_iterator end = lits + size;
+    literal_iterator k = middle;
+
+    // Find replacement watch 'r' at position 'k' with value 'v'.
+
+    int r = 0;
+    signed char v = -1;
+
+    while (k != end && (v = val (r = *k)) < 0)
+      k++;
+
+    if (v < 0) {  // need second search starting at the head?
+
+      k = lits + 2;
+      assert (c->saved_pos () <= size);
+      while (k != middle && (v = val (r = *k)) < 0)
+        k++;
+    }
+
+    c->save_pos (k - lits);  // always save position
+
+    assert (lits + 2 <= k), assert (k <= c->end ());
+
+    if (v > 0) {
+
+      // Replacement satisfied, so just replace 'blit'.
+
+      j[-1].update_blit (r);
+
+    } else if (!v) {
+
+      // Found new unassigned replacement literal to be watched.
+
+      LOG (c, "unwatch %d in", lit);
+
+      lits[0] = other;
+      lits[1] = r;
+      *k = lit;
+
+      watch_literal (r, lit, c);
+
+      j--;  // Drop this watch from the watch list of 'lit'.
+
+    } else if (!u) {
+
+      assert (v < 0);
+
+      // The other watch is unassigned ('!u') and all other literals
+      // assigned to false (still 'v < 0'), thus we found a unit.
+      //
+      lits[0] = other, lits[1] = lit;
+      if (policy.assign (other, c)) j--;
+
+    } else {
+
+      assert (u < 0);
+      assert (v < 0);
+
+      // The other watch is assigned false ('u < 0') and all other
+      // literals as well (still 'v < 0'), thus we found a conflict.
+
+      conflict = c;
+      break;
+    }
+  }
+
+  if (j != i) {
+
+    while (i != eow)
+      *j++ = *i++;
+
+    ws.resize (j - ws.begin ());
+  }
+}
+
+}
+
+#endif
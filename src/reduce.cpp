@@ -166,17 +166,24 @@ bool Internal::propagate_out_of_order_units () {
 void Internal::reduce () {
   START (reduce);
 
+  check_memory_limit ();
+
   stats.reductions++;
   report ('.', 1);
 
   bool flush = flushing ();
   if (flush) stats.flush.count++;
 
+  // Under memory pressure we flush all unused redundant clauses (without
+  // updating the flushing schedule though).
+  //
+  const bool pressure = !flush && lim.memory.pressure;
+
   if (!propagate_out_of_order_units ()) goto DONE;
 
   mark_satisfied_clauses_as_garbage ();
   protect_reasons ();
-  if (flush) mark_clauses_to_be_flushed ();
+  if (flush || pressure) mark_clauses_to_be_flushed ();
   else mark_useless_redundant_clauses_as_garbage ();
   garbage_collection ();
 
@@ -186,6 +193,7 @@ void Internal::reduce () {
       delta *= log (irredundant ()/1e4) / log (10);
       if (delta < 1) delta = 1;
     }
+    if (lim.memory.pressure) delta = (delta + 1) / 2;
     lim.reduce = stats.conflicts + delta;
     PHASE ("reduce", stats.reductions,
       "new reduce limit %" PRId64 " after %" PRId64 " conflicts",
@@ -24,8 +24,15 @@ extern "C" {
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #endif
 
+#endif
+
+#include <stdlib.h>
 #include <string.h>
 }
 
@@ -142,4 +149,109 @@ uint64_t current_resident_set_size () {
 
 /*------------------------------------------------------------------------*/
 
+#ifdef __WIN32
+
+uint64_t minor_page_faults () {
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo (GetCurrentProcess (), &pmc, sizeof (pmc))) {
+     return pmc.PageFaultCount;
+  } else return 0;
+}
+
+uint64_t major_page_faults () { return 0; }
+
+#else
+
+uint64_t minor_page_faults () {
+  struct rusage u;
+  if (getrusage (RUSAGE_SELF, &u)) return 0;
+  return u.ru_minflt;
+}
+
+uint64_t major_page_faults () {
+  struct rusage u;
+  if (getrusage (RUSAGE_SELF, &u)) return 0;
+  return u.ru_majflt;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Data TLB misses can only be counted with hardware performance counters.
+// On Linux we use 'perf_event_open' for the calling thread, which however
+// might not be available (for instance in virtual machines or containers
+// or if 'perf_event_paranoid' is too restrictive).  Then the counter is
+// negative and reading it gives a negative result too.
+
+#ifdef __linux__
+
+int open_tlb_misses_counter () {
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof attr);
+  attr.size = sizeof attr;
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB |
+               (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int64_t read_tlb_misses_counter (int fd) {
+  if (fd < 0) return -1;
+  uint64_t res;
+  if (read (fd, &res, sizeof res) != sizeof res) return -1;
+  return res;
+}
+
+void close_tlb_misses_counter (int fd) { if (fd >= 0) close (fd); }
+
+#else
+
+int open_tlb_misses_counter () { return -1; }
+int64_t read_tlb_misses_counter (int) { return -1; }
+void close_tlb_misses_counter (int) { }
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Large randomly accessed memory regions (the clause arena and variable
+// and literal tables) suffer from TLB misses.  On Linux we align such
+// regions to huge pages of 2 MB and advise the kernel to back them with
+// transparent huge pages.  Memory allocated with 'allocate_huge_pages' has
+// to be released with 'free'.  It returns zero if allocation fails.
+
+static const size_t huge_page_size = (size_t) 1 << 21;
+
+void * allocate_huge_pages (size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (bytes >= huge_page_size) {
+    void * res;
+    if (posix_memalign (&res, huge_page_size, bytes)) return 0;
+    madvise (res, bytes, MADV_HUGEPAGE);
+    return res;
+  }
+#endif
+  return malloc (bytes);
+}
+
+// This variant is used for memory allocated elsewhere (e.g., by 'vector').
+// Only the huge pages completely contained in the range are advised.
+
+void advise_huge_pages (void * p, size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  const uintptr_t mask = huge_page_size - 1;
+  const uintptr_t start = ((uintptr_t) p + mask) & ~mask;
+  const uintptr_t end = ((uintptr_t) p + bytes) & ~mask;
+  if (start < end) madvise ((void *) start, end - start, MADV_HUGEPAGE);
+#else
+  (void) p, (void) bytes;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
 }
@@ -9,6 +9,16 @@ double absolute_process_time ();
 uint64_t maximum_resident_set_size ();
 uint64_t current_resident_set_size ();
 
+uint64_t minor_page_faults ();
+uint64_t major_page_faults ();
+
+int open_tlb_misses_counter ();
+int64_t read_tlb_misses_counter (int);
+void close_tlb_misses_counter (int);
+
+void * allocate_huge_pages (size_t bytes);
+void advise_huge_pages (void *, size_t bytes);
+
 }
 
 #endif // ifndef _resources_hpp_INCLUDED
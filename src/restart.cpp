@@ -98,6 +98,7 @@ void Internal::restart () {
   if (stable) stats.restartstable++;
   LOG ("restart %" PRId64 "", stats.restarts);
   backtrack (reuse_trail ());
+  external->flush_learned_clauses ();
 
   lim.restart = stats.conflicts + opts.restartint;
   LOG ("new restart limit at %" PRId64 " conflicts", lim.restart);
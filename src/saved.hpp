@@ -0,0 +1,23 @@
+#ifndef _saved_hpp_INCLUDED
+#define _saved_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+struct Clause;
+
+// Literals unassigned during backtracking are saved in this form on the
+// saved trail together with their reason (see 'backtrack.cpp').  Decisions
+// are saved with a zero reason.
+
+struct Saved {
+
+  int lit;
+  Clause * reason;
+
+  Saved (int l, Clause * r) : lit (l), reason (r) { }
+  Saved () { }
+};
+
+}
+
+#endif
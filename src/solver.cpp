@@ -531,6 +531,24 @@ void Solver::add (int lit) {
   LOG_API_CALL_END ("add", lit);
 }
 
+void Solver::add_clauses (const vector<int> & lits) {
+#ifndef NTRACING
+  if (trace_api_file) {
+    for (const auto & lit : lits)
+      add (lit);
+    return;
+  }
+#endif
+  LOG_API_CALL_BEGIN ("add_clauses");
+  REQUIRE_VALID_STATE ();
+  if (lits.empty ()) return;
+  transition_to_unknown_state ();
+  external->add (lits.data (), lits.size ());
+  if (lits.back ()) STATE (ADDING);
+  else              STATE (UNKNOWN);
+  LOG_API_CALL_END ("add_clauses");
+}
+
 void Solver::assume (int lit) {
   TRACE ("assume", lit);
   REQUIRE_VALID_STATE ();
@@ -548,16 +566,34 @@ int Solver::lookahead () {
   return lit;
 }
 
+class CubeCollector : public CubeIterator {
+public:
+  std::vector<std::vector<int>> cubes;
+  bool cube (const std::vector<int> & c) {
+    cubes.push_back (c);
+    return true;
+  }
+};
+
 Solver::CubesWithStatus Solver::generate_cubes (int depth, int min_depth) {
   TRACE ("lookahead_cubes");
   REQUIRE_VALID_OR_SOLVING_STATE ();
-  auto cubes = external->generate_cubes (depth, min_depth);
+  CubeCollector collector;
+  const int status = external->generate_cubes (depth, min_depth, collector);
   TRACE ("lookahead_cubes");
 
-  CubesWithStatus cubes2;
-  cubes2.status = cubes.status;
-  cubes2.cubes = cubes.cubes;
-  return cubes2;
+  CubesWithStatus cubes;
+  cubes.status = status;
+  cubes.cubes = std::move (collector.cubes);
+  return cubes;
+}
+
+int Solver::generate_cubes (int depth, CubeIterator & it, int min_depth) {
+  TRACE ("lookahead_cubes");
+  REQUIRE_VALID_OR_SOLVING_STATE ();
+  const int res = external->generate_cubes (depth, min_depth, it);
+  TRACE ("lookahead_cubes");
+  return res;
 }
 
 void Solver::reset_assumptions () {
@@ -734,6 +770,38 @@ void Solver::disconnect_learner () {
   LOG_API_CALL_END ("disconnect_learner");
 }
 
+void Solver::connect_batch_learner (BatchLearner * learner,
+                                    int max_size, int max_glue) {
+  LOG_API_CALL_BEGIN ("connect_batch_learner");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (learner, "can not connect zero batch learner");
+#ifdef LOGGING
+  if (external->batch_learner)
+    LOG ("connecting new batch learner (disconnecting previous one)");
+  else
+    LOG ("connecting new batch learner (no previous one)");
+#endif
+  external->batch_learner = learner;
+  external->batch_size = max_size;
+  external->batch_glue = max_glue;
+  external->exported.clear ();
+  LOG_API_CALL_END ("connect_batch_learner");
+}
+
+void Solver::disconnect_batch_learner () {
+  LOG_API_CALL_BEGIN ("disconnect_batch_learner");
+  REQUIRE_VALID_STATE ();
+#ifdef LOGGING
+    if (external->batch_learner)
+      LOG ("disconnecting previous batch learner");
+    else
+      LOG ("ignoring to disconnect batch learner (no previous one)");
+#endif
+  external->batch_learner = 0;
+  external->exported.clear ();
+  LOG_API_CALL_END ("disconnect_batch_learner");
+}
+
 void Solver::connect_learn_source (LearnSource * learnSource) {
   external->learnSource = learnSource;
 }
@@ -759,6 +827,8 @@ Solver::Statistics Solver::get_stats () {
   s.r_el = internal->stats.clauseimport.r_el;
   s.r_fx = internal->stats.clauseimport.r_fx;
   s.r_wit = internal->stats.clauseimport.r_wit;
+  s.r_dup = internal->stats.clauseimport.r_dup;
+  s.e_dup = internal->stats.clauseimport.e_dup;
   return s;
 }
 
@@ -1158,6 +1228,74 @@ const char * Solver::write_dimacs (const char * path, int min_max_var) {
 
 /*------------------------------------------------------------------------*/
 
+// Cubes are written as iCNF 'a' lines and flushed immediately, such that
+// a consumer reading the file concurrently can start with the first cubes
+// while later ones are still being generated.
+
+class CubeWriter : public CubeIterator {
+  File * file;
+public:
+  int64_t cubes;
+  bool failed;
+  CubeWriter (File * f) : file (f), cubes (0), failed (false) { }
+  bool cube (const vector<int> & c) {
+    failed = !file->put ("a ");
+    for (const auto & lit : c) {
+      if (failed) break;
+      failed = !file->put (lit) || !file->put (' ');
+    }
+    if (!failed) failed = !file->put ("0\n");
+    if (failed) return false;
+    file->flush ();
+    cubes++;
+    return true;
+  }
+};
+
+const char *
+Solver::write_cubes (const char * path, int depth, int min_depth) {
+  LOG_API_CALL_BEGIN ("write_cubes", path, depth);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (depth > 0, "expected positive cube depth");
+#ifndef QUIET
+  const double start = internal->time ();
+#endif
+  internal->restore_clauses ();
+  File * file = File::write (internal, path);
+  const char * res = 0;
+  if (file) {
+    MSG ("writing %s'p inccnf'%s header",
+      tout.green_code (), tout.normal_code ());
+    file->put ("p inccnf\n");
+    ClauseWriter clauses (file);
+    CubeWriter writer (file);
+    if (!traverse_clauses (clauses)) writer.failed = true;
+    else {
+      file->flush ();
+      (void) generate_cubes (depth, writer, min_depth);
+      if (!writer.failed && !writer.cubes)
+        writer.failed = !file->put ("a 0\n");
+    }
+    if (writer.failed)
+      res = internal->error_message.init (
+              "writing to iCNF file '%s' failed", path);
+#ifndef QUIET
+    else {
+      const double end = internal->time ();
+      MSG ("wrote %" PRId64 " cubes in %.2f seconds %s time",
+        writer.cubes, end - start,
+        internal->opts.realtime ? "real" : "process");
+    }
+#endif
+    delete file;
+  } else res = internal->error_message.init (
+                 "failed to open iCNF file '%s' for writing", path);
+  LOG_API_CALL_RETURNS ("write_cubes", path, depth, res);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 struct WitnessWriter : public WitnessIterator {
   File * file;
   int64_t witnesses;
@@ -1243,6 +1381,16 @@ void Solver::copy (Solver & other) const {
   external->copy_flags (*other.external);
 }
 
+Solver * Solver::clone () const {
+  REQUIRE_READY_STATE ();
+  Solver * res = new Solver ();
+  external->clone (*res->external);
+  // Directly enter 'UNKNOWN' without 'transition_to_unknown_state' since
+  // an online proof checker would not know about the cloned clauses.
+  res->_state = UNKNOWN;
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 void Solver::section (const char * title) {
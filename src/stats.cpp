@@ -49,6 +49,9 @@ void Stats::print (Internal * internal) {
   propagations += stats.propagations.walk;
 
   int64_t vivified = stats.vivifysubs + stats.vivifystrs;
+  int64_t received = stats.clauseimport.imported + stats.clauseimport.discarded;
+  int64_t dupimported = stats.clauseimport.r_dup;
+  int64_t dupexported = stats.clauseimport.e_dup;
 
   size_t extendbytes = internal->external->extension.size ();
   extendbytes *= sizeof (int);
@@ -93,6 +96,11 @@ void Stats::print (Internal * internal) {
   PRT ("decisions:       %15" PRId64 "   %10.2f    per second", stats.decisions, relative (stats.decisions, t));
   PRT ("  searched:      %15" PRId64 "   %10.2f    per decision", stats.searched, relative (stats.searched, stats.decisions));
   }
+  if (all || dupimported || dupexported) {
+  PRT ("duplicated:      %15" PRId64 "   %10.2f %%  of shared", dupimported + dupexported, percent (dupimported + dupexported, received + dupexported));
+  PRT ("  dupimported:   %15" PRId64 "   %10.2f %%  of received", dupimported, percent (dupimported, received));
+  PRT ("  dupexported:   %15" PRId64 "   %10.2f %%  per conflict", dupexported, percent (dupexported, stats.conflicts));
+  }
   if (all || stats.all.eliminated) {
   PRT ("eliminated:      %15" PRId64 "   %10.2f %%  of all variables", stats.all.eliminated, percent (stats.all.eliminated, stats.vars));
   PRT ("  elimphases:    %15" PRId64 "   %10.2f    interval", stats.elimphases, relative (stats.conflicts, stats.elimphases));
@@ -128,6 +136,14 @@ void Stats::print (Internal * internal) {
   PRT ("  hyper:         %15" PRId64 "   %10.2f %%  per conflict", stats.flush.hyper, relative (stats.flush.hyper, stats.conflicts));
   PRT ("  flushings:     %15" PRId64 "   %10.2f    interval", stats.flush.count, relative (stats.conflicts, stats.flush.count));
   }
+  if (all || received) {
+  PRT ("imported:        %15" PRId64 "   %10.2f %%  of received", (int64_t) stats.clauseimport.imported, percent (stats.clauseimport.imported, received));
+  PRT ("  discarded:     %15" PRId64 "   %10.2f %%  of received", (int64_t) stats.clauseimport.discarded, percent (stats.clauseimport.discarded, received));
+  PRT ("  impeliminated: %15" PRId64 "   %10.2f %%  of discarded", (int64_t) stats.clauseimport.r_el, percent (stats.clauseimport.r_el, stats.clauseimport.discarded));
+  PRT ("  impfixed:      %15" PRId64 "   %10.2f %%  of discarded", (int64_t) stats.clauseimport.r_fx, percent (stats.clauseimport.r_fx, stats.clauseimport.discarded));
+  PRT ("  impwitness:    %15" PRId64 "   %10.2f %%  of discarded", (int64_t) stats.clauseimport.r_wit, percent (stats.clauseimport.r_wit, stats.clauseimport.discarded));
+  PRT ("  impreactive:   %15" PRId64 "   %10.2f    per imported", (int64_t) stats.clauseimport.reactivated, relative (stats.clauseimport.reactivated, stats.clauseimport.imported));
+  }
   if (all || stats.instantiated) {
   PRT ("instantiated:    %15" PRId64 "   %10.2f %%  of tried", stats.instantiated, percent (stats.instantiated, stats.instried));
   PRT ("  instrounds:    %15" PRId64 "   %10.2f %%  of elimrounds", stats.instrounds, percent (stats.instrounds, stats.elimrounds));
@@ -172,6 +188,7 @@ void Stats::print (Internal * internal) {
   PRT ("reduced:         %15" PRId64 "   %10.2f %%  per conflict", stats.reduced, percent (stats.reduced, stats.conflicts));
   PRT ("  reductions:    %15" PRId64 "   %10.2f    interval", stats.reductions, relative (stats.conflicts, stats.reductions));
   PRT ("  collections:   %15" PRId64 "   %10.2f    interval", stats.collections, relative (stats.conflicts, stats.collections));
+  PRT ("  minors:        %15" PRId64 "   %10.2f %%  of collections", stats.minorcollections, percent (stats.minorcollections, stats.collections));
   }
   if (all || stats.rephased.total) {
   PRT ("rephased:        %15" PRId64 "   %10.2f    interval", stats.rephased.total, relative (stats.conflicts, stats.rephased.total));
@@ -231,6 +248,11 @@ void Stats::print (Internal * internal) {
   PRT ("  htr3:          %15" PRId64 "   %10.2f %%  ternary hyper ternres", stats.htrs3, percent (stats.htrs3, stats.htrs));
   PRT ("  htr2:          %15" PRId64 "   %10.2f %%  binary hyper ternres", stats.htrs2, percent (stats.htrs2, stats.htrs));
   }
+  if (all || stats.trailsave.saved) {
+  PRT ("trailsaved:      %15" PRId64 "   %10.2f    per backtrack", stats.trailsave.saved, relative (stats.trailsave.saved, stats.backtracks));
+  PRT ("  replayed:      %15" PRId64 "   %10.2f %%  of saved", stats.trailsave.replayed, percent (stats.trailsave.replayed, stats.trailsave.saved));
+  PRT ("  conflicts:     %15" PRId64 "   %10.2f %%  of conflicts", stats.trailsave.conflicts, percent (stats.trailsave.conflicts, stats.conflicts));
+  }
   if (all || vivified) {
   PRT ("vivified:        %15" PRId64 "   %10.2f %%  of all clauses", vivified, percent (vivified, stats.added.total));
   PRT ("  vivifications: %15" PRId64 "   %10.2f    interval", stats.vivifications, relative (stats.conflicts, stats.vivifications));
@@ -280,6 +302,11 @@ void Internal::print_resource_usage () {
   MSG ("total process time since initialization: %12.2f    seconds", internal->process_time ());
   MSG ("total real time since initialization:    %12.2f    seconds", internal->real_time ());
   MSG ("maximum resident set size of process:    %12.2f    MB", m/(double)(1l<<20));
+  MSG ("minor page faults of process:            %12" PRIu64 "", minor_page_faults ());
+  MSG ("major page faults of process:            %12" PRIu64 "", major_page_faults ());
+  const int64_t t = read_tlb_misses_counter (tlb_misses_counter);
+  if (t >= 0)
+    MSG ("data TLB read misses of solver thread:   %12" PRId64 "", t);
 #endif
 }
 
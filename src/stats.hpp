@@ -78,6 +78,12 @@ struct Stats {
     int64_t walk;       // phases improved through random walked
   } rephased;
 
+  struct {
+    int64_t saved;      // literals saved during backtracking
+    int64_t replayed;   // saved literals assigned again
+    int64_t conflicts;  // conflicts found while replaying
+  } trailsave;
+
   struct {
     int64_t count;
     int64_t broken;
@@ -115,6 +121,7 @@ struct Stats {
   int64_t reduced;      // number of reduced clauses
   int64_t collected;    // number of collected bytes
   int64_t collections;  // number of garbage collections
+  int64_t minorcollections; // minor (young generation only) collections
   int64_t hbrs;         // hyper binary resolvents
   int64_t hbrsizes;     // sum of hyper resolved base clauses
   int64_t hbreds;       // redundant hyper binary resolvents
@@ -222,7 +229,9 @@ struct Stats {
   struct {
     unsigned long imported;
     unsigned long discarded;
-    unsigned long r_wit,r_el,r_fx;
+    unsigned long r_wit,r_el,r_fx,r_dup;
+    unsigned long e_dup;  // duplicated exported clauses
+    unsigned long reactivated;  // variables reactivated for importing
   } clauseimport;
 
   Stats ();
@@ -142,6 +142,7 @@ Internal::subsume_clause (Clause * subsuming, Clause * subsumed) {
   if (subsumed->redundant || !subsuming->redundant) return;
   LOG ("turning redundant subsuming clause into irredundant clause");
   subsuming->redundant = false;
+  if (counting_loccs ()) inc_loccs (subsuming);
   stats.current.irredundant++;
   stats.added.irredundant++;
   stats.irrbytes += subsuming->bytes ();
@@ -161,7 +162,10 @@ void Internal::strengthen_clause (Clause * c, int lit) {
   assert (c->size > 2);
   LOG (c, "removing %d in", lit);
   if (proof) proof->strengthen_clause (c, lit);
-  if (!c->redundant) mark_removed (lit);
+  if (!c->redundant) {
+    mark_removed (lit);
+    if (counting_loccs ()) dec_locc (lit);
+  }
   auto new_end = remove (c->begin (), c->end (), lit);
   assert (new_end + 1 == c->end ()), (void) new_end;
   (void) shrink_clause (c, c->size - 1);
@@ -581,6 +585,8 @@ void Internal::subsume (bool update_limits) {
     return;
   }
 
+  check_memory_limit ();
+
   if (opts.subsume) {
     reset_watches ();
     subsume_round ();
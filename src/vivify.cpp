@@ -1,4 +1,5 @@
 #include "internal.hpp"
+#include "propagate.hpp"
 
 namespace CaDiCaL {
 
@@ -77,85 +78,49 @@ void Internal::vivify_assume (int lit) {
   vivify_assign (lit, 0);
 }
 
-// Dedicated routine similar to 'propagate' in 'propagate.cpp' and
-// 'probe_propagate' with 'probe_propagate2' in 'probe.cpp'.  Please refer
-// to that code for more explanation on how propagation is implemented.
+// Dedicated propagation policy and routine similar to 'propagate' in
+// 'propagate.cpp' and 'probe_propagate' in 'probe.cpp', sharing the actual
+// propagation loops in 'propagate.hpp'.  It skips the 'ignore' clause.
+// Inline ternary watches are not used, since vivified (ternary) clauses
+// become garbage while still being watched, and propagating them without
+// checking the 'garbage' flag could use a subsumed clause to subsume its
+// subsuming clause.
+
+struct VivifyPropagation {
+
+  static const bool simd = false;
+  static const bool ignore = true;
+  static const bool ternary = false;
+
+  Internal * internal;
+
+  VivifyPropagation (Internal * i) : internal (i) { }
+
+  bool vectorize () const { return false; }
+
+  void assign (int lit, Clause * c, int) { internal->vivify_assign (lit, c); }
+
+  bool assign (int lit, Clause * c) {
+    internal->vivify_assign (lit, c);
+    return false;
+  }
+};
 
 bool Internal::vivify_propagate () {
   require_mode (VIVIFY);
   assert (!unsat);
   START (propagate);
+  VivifyPropagation policy (this);
   int64_t before = propagated2 = propagated;
   for (;;) {
     if (propagated2 != trail.size ()) {
       const int lit = -trail[propagated2++];
       LOG ("vivify propagating %d over binary clauses", -lit);
-      Watches & ws = watches (lit);
-      for (const auto & w : ws) {
-        if (!w.binary ()) continue;
-        const signed char b = val (w.blit);
-        if (b > 0) continue;
-        if (b < 0) conflict = w.clause;                 // but continue
-        else vivify_assign (w.blit, w.clause);
-      }
+      propagate_binary_watches (policy, lit);
     } else if (!conflict && propagated != trail.size ()) {
       const int lit = -trail[propagated++];
       LOG ("vivify propagating %d over large clauses", -lit);
-      Watches & ws = watches (lit);
-      const const_watch_iterator eow = ws.end ();
-      const_watch_iterator i = ws.begin ();
-      watch_iterator j = ws.begin ();
-      while (i != eow) {
-        const Watch w = *j++ = *i++;
-        if (w.binary ()) continue;
-        if (val (w.blit) > 0) continue;
-        if (w.clause->garbage) { j--; continue; }
-        if (w.clause == ignore) continue;
-        literal_iterator lits = w.clause->begin ();
-        const int other = lits[0]^lits[1]^lit;
-        const signed char u = val (other);
-        if (u > 0) j[-1].blit = other;
-        else {
-          const int size = w.clause->size;
-          const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
-          literal_iterator k = middle;
-          signed char v = -1;
-          int r = 0;
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
-          if (v < 0) {
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
-          }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
-          if (v > 0) j[-1].blit = r;
-          else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
-            lits[0] = other;
-            lits[1] = r;
-            *k = lit;
-            watch_literal (r, lit, w.clause);
-            j--;
-          } else if (!u) {
-            assert (v < 0);
-            vivify_assign (other, w.clause);
-          } else {
-            assert (u < 0);
-            assert (v < 0);
-            conflict = w.clause;
-            break;
-          }
-        }
-      }
-      if (j != i) {
-        while (i != eow)
-          *j++ = *i++;
-        ws.resize (j - ws.begin ());
-      }
+      propagate_watches (policy, lit);
     } else break;
   }
   int64_t delta = propagated2 - before;
@@ -112,6 +112,19 @@ Clause * Internal::walk_pick_clause (Walker & walker) {
 
 /*------------------------------------------------------------------------*/
 
+// Local search uses a one-watch scheme, where all clauses are watched by a
+// satisfied literal.  Binary clauses are not special here and thus, in
+// contrast to 'watch_literal', we keep them in the same watch lists as the
+// long clauses (all watches are cleared and reconnected after 'walk').
+
+inline void Internal::walk_watch_literal (int lit, int blit, Clause * c) {
+  assert (lit != blit);
+  watchstore.push_back (watches (lit), make_watch (lit, blit, c));
+  LOG (c, "watch %d blit %d in", lit, blit);
+}
+
+/*------------------------------------------------------------------------*/
+
 // Compute the number of clauses which would be become unsatisfied if 'lit'
 // is flipped and set to false.  This is called the 'break-count' of 'lit'.
 
@@ -127,7 +140,7 @@ unsigned Internal::walk_break_value (int lit) {
     if (val (w.blit) > 0) continue;
     if (w.binary ()) { res++; continue; }
 
-    Clause * c = w.clause;
+    Clause * c = watched_clause (w);
     assert (lit == c->literals[0]);
 
     // Now try to find a second satisfied literal starting at 'literals[1]'
@@ -148,7 +161,7 @@ unsigned Internal::walk_break_value (int lit) {
 
       // Found 'other' as second satisfying literal.
 
-      w.blit = other;                   // Update 'blit'
+      w.update_blit (other);            // Update 'blit'
       *begin = other;                   // and move to front.
 
       break;
@@ -296,7 +309,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
       if (prev == lit) {
         literals[0] = lit;
         LOG (d, "made");
-        watch_literal (literals[0], literals[1], d);
+        walk_watch_literal (literals[0], literals[1], d);
         made++;
         j--;
 
@@ -335,7 +348,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
     LOG ("trying to brake %zd watched clauses", ws.size ());
 
     for (const auto w : ws) {
-      Clause * d = w.clause;
+      Clause * d = watched_clause (w);
       LOG (d, "unwatch %d in", -lit);
       int * literals = d->literals, replacement = 0, prev = -lit;
       assert (literals[0] == -lit);
@@ -354,7 +367,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
         literals[1] = -lit;
         literals[0] = replacement;
         assert (-lit != replacement);
-        watch_literal (replacement, -lit, d);
+        walk_watch_literal (replacement, -lit, d);
       } else {
         for (int i = size-1; i > 0; i--) {      // undo shift
           const int other = literals[i];
@@ -538,7 +551,7 @@ int Internal::walk_round (int64_t limit, bool prev) {
       }
 
       if (satisfied) {
-        watch_literal (lits[0], lits[1], c);
+        walk_watch_literal (lits[0], lits[1], c);
 #ifdef LOGGING
         watched++;
 #endif
@@ -2,24 +2,135 @@
 
 namespace CaDiCaL {
 
+/*------------------------------------------------------------------------*/
+
+// Minimum size of a chunk (in number of watches) and of a watch list.
+
+static const size_t min_chunk_size = 1 << 16;
+static const unsigned min_list_size = 4;
+
+WatchStore::WatchStore (Internal * i) :
+  internal (i), top (0), end (0), allocated (0)
+{
+}
+
+WatchStore::~WatchStore () { release (); }
+
+void WatchStore::add_chunk (size_t size) {
+  if (size < min_chunk_size) size = min_chunk_size;
+  const size_t bytes = size * sizeof (Watch);
+  void * p;
+  if (internal->opts.hugepages) p = allocate_huge_pages (bytes);
+  else p = malloc (bytes);
+  if (!p) throw std::bad_alloc ();
+  LOG ("new watch chunk of %zd watches", size);
+  top = (Watch *) p;
+  end = top + size;
+  chunks.push_back (top);
+  allocated += size;
+}
+
+inline Watch * WatchStore::allocate (size_t size) {
+  if ((size_t) (end - top) < size) add_chunk (max (size, allocated));
+  Watch * res = top;
+  top += size;
+  return res;
+}
+
+// Called if a watch list is full.  Since lists are only shrunken in place
+// its old place is left as a hole until the next 'defrag_watches'.
+
+void WatchStore::enlarge (Watches & ws) {
+  unsigned new_allocated = 2 * ws.allocated;
+  if (new_allocated < min_list_size) new_allocated = min_list_size;
+  Watch * p = allocate (new_allocated);
+  if (ws.count) memcpy (p, ws.watches, ws.count * sizeof (Watch));
+  ws.watches = p;
+  ws.allocated = new_allocated;
+}
+
+void WatchStore::start (size_t size) {
+  assert (old.empty ());
+  old.swap (chunks);
+  allocated = 0;
+  top = end = 0;
+  if (size) add_chunk (size);
+}
+
+void WatchStore::move (Watches & ws) {
+  if (!ws.count) { ws.watches = 0, ws.allocated = 0; return; }
+  const unsigned new_allocated = ws.count + ws.count/4 + 1;
+  Watch * p = allocate (new_allocated);
+  memcpy (p, ws.watches, ws.count * sizeof (Watch));
+  ws.watches = p;
+  ws.allocated = new_allocated;
+}
+
+void WatchStore::finish () {
+  for (const auto & p : old) free (p);
+  erase_vector (old);
+}
+
+void WatchStore::release () {
+  for (const auto & p : chunks) free (p);
+  erase_vector (chunks);
+  finish ();
+  allocated = 0;
+  top = end = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 void Internal::init_watches () {
   assert (wtab.empty ());
+  assert (bwtab.empty ());
   while (wtab.size () < 2*vsize)
     wtab.push_back (Watches ());
+  while (bwtab.size () < 2*vsize)
+    bwtab.push_back (Watches ());
   LOG ("initialized watcher tables");
 }
 
 void Internal::clear_watches () {
-  for (auto lit : lits)
+  for (auto lit : lits) {
     watches (lit).clear ();
+    binary_watches (lit).clear ();
+  }
 }
 
 void Internal::reset_watches () {
   assert (!wtab.empty ());
   erase_vector (wtab);
+  erase_vector (bwtab);
+  watchstore.release ();
   LOG ("reset watcher tables");
 }
 
+// Remove holes from the watch store and place the watch lists of all
+// literals in variable order, the binary watches of a literal directly
+// before its long clause watches (as they are traversed in 'propagate').
+// This requires an additional copy of all watches temporarily.
+
+void Internal::defrag_watches () {
+  assert (watching ());
+  size_t size = 0;
+  for (auto lit : lits) {
+    const size_t b = binary_watches (lit).size ();
+    const size_t l = watches (lit).size ();
+    if (b) size += b + b/4 + 1;
+    if (l) size += l + l/4 + 1;
+  }
+  LOG ("defragmenting %zd watches", size);
+  watchstore.start (size + size/2);
+  for (auto idx : vars)
+    for (int sign = 1; sign >= -1; sign -= 2) {
+      const int lit = sign * idx;
+      watchstore.move (binary_watches (lit));
+      watchstore.move (watches (lit));
+    }
+  watchstore.finish ();
+}
+
 // This can be quite costly since lots of memory is accessed in a rather
 // random fashion, and thus we optionally profile it.
 
@@ -67,34 +178,9 @@ void Internal::connect_watches (bool irredundant_only) {
     }
   }
 
-  STOP (connect);
-}
+  defrag_watches ();
 
-void Internal::sort_watches () {
-  assert (watching ());
-  LOG ("sorting watches");
-  Watches saved;
-  for (auto lit : lits) {
-    Watches & ws = watches (lit);
-
-    const const_watch_iterator end = ws.end ();
-    watch_iterator j = ws.begin ();
-    const_watch_iterator i;
-
-    assert (saved.empty ());
-
-    for (i = j; i != end; i++) {
-      const Watch w = *i;
-      if (w.binary ()) *j++ = w;
-      else saved.push_back (w);
-    }
-    ws.resize (j - ws.begin ());
-
-    for (const auto & w : saved)
-      ws.push_back (w);
-
-    saved.clear ();
-  }
+  STOP (connect);
 }
 
 }
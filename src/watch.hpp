@@ -2,6 +2,7 @@
 #define _watch_hpp_INCLUDED
 
 #include <cassert>
+#include <climits>
 #include <vector>
 
 namespace CaDiCaL {
@@ -15,34 +16,161 @@ namespace CaDiCaL {
 // to use at least one more bit (either taken away from the variable space
 // or the clauses) to denote whether the watch is binary.
 
+// Binary clause watches are kept in separate per-literal watch lists (see
+// 'binary_watches' in 'internal.hpp').  These lists form the binary
+// implication graph and are traversed in a tight loop before any long
+// clause watch is touched in 'propagate'.  The binary clause itself is
+// never accessed during propagation (only the blocking literal, which is
+// the other literal of the clause) but is still kept as reason for
+// conflict analysis and proof tracing.  Thus binary clauses are not stored
+// implicitly and still take the same space in the arena.  Dropping their
+// 'Clause' objects would require literal pairs as reasons in analysis,
+// minimization, shrinking, probing and all users of 'reason' pointers.
+
+// If compiled with '-DWATCH32' (see './configure --watch32') we use such
+// 32-bit references instead.  All clauses are then allocated in the arena
+// (see 'arena.hpp') and referenced by their offset in the reserved arena
+// address space in units of 8 bytes (clauses are 8 byte aligned).  The
+// least significant bit of the reference denotes binary clauses, which
+// gives an 8 byte watch and thus halves the memory needed for watches.
+// This restricts the arena to 16 GB though.  The clause of a watch is
+// obtained with 'watched_clause' and new watches are generated with
+// 'make_watch' in 'internal.hpp'.
+
+// Without '-DWATCH32' the four bytes after the blocking literal are used to
+// keep the remaining literal of ternary clauses inline.  Thus for ternary
+// clauses the blocking literal and this 'third' literal are the two other
+// literals of the clause, and propagation can determine whether the clause
+// is satisfied, unit or falsified without accessing the clause (similar to
+// binary clauses).  Only if both are unassigned the watch has to be moved
+// and the clause is accessed.  With '-DWATCH32' there is no space left for
+// this inline literal.
+
 struct Clause;
 
 struct Watch {
 
+#ifdef WATCH32
+
+  int blit;
+  unsigned ref;       // offset in arena in 8 bytes shifted and binary bit
+
+  Watch (int b, unsigned r) : blit (b), ref (r) { }
+  Watch () { }
+
+  bool binary () const { return ref & 1; }
+  bool ternary () const { return false; }
+
+  void update_blit (int b) { blit = b; }
+
+#else
+
   Clause * clause; int blit;
-  int size;
+  int third;          // ternary: third literal, binary: 0, else 'INT_MIN'
 
-  Watch (int b, Clause * c) : clause (c), blit (b), size (c->size) { }
+  Watch (int b, Clause * c, int t) : clause (c), blit (b), third (t) { }
   Watch () { }
 
-  bool binary () const { return size == 2; }
+  bool binary () const { return !third; }
+  bool ternary () const { return third && third != INT_MIN; }
+
+  // Replace the blocking literal by another literal of the clause (which
+  // for ternary clauses might be the inline third literal).
+  //
+  void update_blit (int b) { if (third == b) third = blit; blit = b; }
+
+#endif
 };
 
-typedef vector<Watch> Watches;          // of one literal
+// The watch lists of all literals are kept in one pool ('WatchStore')
+// instead of using one separately allocated 'vector' per literal.  The
+// 'Watches' of a literal is only a header pointing into that pool and
+// provides the part of the 'vector' interface used in the rest of the
+// code.  The only difference is that pushing a new watch requires the pool
+// (see 'WatchStore::push_back').  If the list is full it is moved to a new
+// and larger place at the end of the pool.  This leaves a hole in the pool
+// but never moves other lists, so iterators to other lists stay valid
+// (the same contract as with vectors).  Holes are removed during garbage
+// collection in 'defrag_watches' (see 'watch.cpp'), which also places the
+// binary and long clause watches of each literal next to each other.
+
+struct Internal;
+class WatchStore;
+
+class Watches {
+
+  friend class WatchStore;
+
+  Watch * watches;              // start of this list in the pool
+  unsigned count;               // number of watches
+  unsigned allocated;           // reserved in the pool
+
+public:
+
+  typedef Watch * iterator;
+  typedef const Watch * const_iterator;
+
+  Watches () : watches (0), count (0), allocated (0) { }
+
+  iterator begin () { return watches; }
+  iterator end () { return watches + count; }
+  const_iterator begin () const { return watches; }
+  const_iterator end () const { return watches + count; }
+
+  size_t size () const { return count; }
+  size_t capacity () const { return allocated; }
+  bool empty () const { return !count; }
+
+  Watch & operator [] (size_t i) { assert (i < count); return watches[i]; }
+  const Watch & operator [] (size_t i) const {
+    assert (i < count);
+    return watches[i];
+  }
+
+  void clear () { count = 0; }
+
+  // Only shrinking is supported (as 'resize' on vectors is used).
+  //
+  void resize (size_t n) { assert (n <= count); count = n; }
+};
 
 typedef Watches::iterator watch_iterator;
 typedef Watches::const_iterator const_watch_iterator;
 
-inline void remove_watch (Watches & ws, Clause * clause) {
-  const auto end = ws.end ();
-  auto i = ws.begin ();
-  for (auto j = i; j != end; j++) {
-    const Watch & w = *i++ = *j;
-    if (w.clause == clause) i--;
+class WatchStore {
+
+  Internal * internal;
+
+  vector<Watch *> chunks;       // all allocated chunks of the pool
+  vector<Watch *> old;          // chunks to be released after 'start'
+  Watch * top, * end;           // free space at the end of last chunk
+  size_t allocated;             // number of watches in all chunks
+
+  Watch * allocate (size_t);
+  void add_chunk (size_t);
+  void enlarge (Watches &);
+
+public:
+
+  WatchStore (Internal *);
+  ~WatchStore ();
+
+  void push_back (Watches & ws, const Watch & w) {
+    if (ws.count == ws.allocated) enlarge (ws);
+    ws.watches[ws.count++] = w;
   }
-  assert (i + 1 == end);
-  ws.resize (i - ws.begin ());
-}
+
+  // Start defragmentation by moving all chunks out of the way and
+  // allocating one fresh chunk for 'size' watches.  Then lists are moved
+  // to that chunk with 'move' and 'finish' releases the old chunks.
+  //
+  void start (size_t size);
+  void move (Watches &);
+  void finish ();
+
+  void release ();              // release all memory
+  size_t bytes () const { return allocated * sizeof (Watch); }
+};
 
 }
 
@@ -0,0 +1,83 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <vector>
+
+#include "random.hpp"
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Random 3-CNF close to the threshold.
+
+static vector<int> formula (int vars, int clauses) {
+  vector<int> res;
+  RandomLiterals random (vars);
+  for (int i = 0; i < clauses; i++) {
+    for (int j = 0; j < 3; j++)
+      res.push_back (random.lit ());
+    res.push_back (0);
+  }
+  return res;
+}
+
+static bool satisfies (Solver & solver, const vector<int> & cnf) {
+  bool satisfied = false;
+  for (const auto & lit : cnf)
+    if (!lit) {
+      if (!satisfied) return false;
+      satisfied = false;
+    } else if (solver.val (lit) > 0) satisfied = true;
+  return true;
+}
+
+int main () {
+
+  const vector<int> cnf = formula (200, 852);
+
+  Solver solver;
+  for (const auto & lit : cnf) solver.add (lit);
+
+  // Learn clauses and simplify before cloning (the formula is not solved
+  // within this limit).
+
+  solver.limit ("conflicts", 2000);
+  int res = solver.solve ();
+
+  if (!res) {
+    Solver * clone = solver.clone ();
+    assert (clone->vars () == solver.vars ());
+    res = solver.solve ();
+    int other = clone->solve ();
+    assert (res == other);
+    if (res == 10) {
+      assert (satisfies (solver, cnf));
+      assert (satisfies (*clone, cnf));
+    }
+
+    // The clone is independent from and incremental as the original.
+
+    clone->add (-1), clone->add (0);
+    clone->add (2), clone->add (0);
+    other = clone->solve ();
+    if (other == 10) {
+      assert (satisfies (*clone, cnf));
+      assert (clone->val (1) == -1);
+      assert (clone->val (2) == 2);
+    }
+    delete clone;
+  }
+
+  // Cloning after a satisfying or unsatisfiable call.
+
+  Solver * clone = solver.clone ();
+  assert (clone->solve () == res);
+  if (res == 10) assert (satisfies (*clone, cnf));
+  delete clone;
+
+  return 0;
+}
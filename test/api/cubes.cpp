@@ -0,0 +1,129 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace CaDiCaL;
+
+static string path (const char * suffix) {
+  const char * prefix = getenv ("CADICALBUILD");
+  string res = prefix ? prefix : ".";
+  res += "/test-api-cubes.";
+  res += suffix;
+  return res;
+}
+
+// Pigeon hole formula with 'n' holes and 'n + 1' pigeons (unsatisfiable).
+
+static int var (int p, int h, int holes) { return 1 + p * holes + h; }
+
+static void formula (Solver & solver, int n) {
+  const int pigeons = n + 1, holes = n;
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < holes; h++)
+      solver.add (var (p, h, holes));
+    solver.add (0);
+  }
+  for (int h = 0; h < holes; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+        solver.add (-var (p, h, holes)),
+        solver.add (-var (q, h, holes)),
+        solver.add (0);
+}
+
+// Solves each cube as soon as it is generated on a second solver.
+
+struct CubeSolver : CubeIterator {
+  Solver & solver;
+  int cubes, limit;
+  CubeSolver (Solver & s, int l = -1) : solver (s), cubes (0), limit (l) { }
+  bool cube (const vector<int> & c) {
+    assert (!c.empty ());
+    for (const auto & lit : c) solver.assume (lit);
+    int res = solver.solve ();
+    assert (res == 20);
+    return ++cubes != limit;
+  }
+};
+
+int main () {
+
+  {
+    Solver generator, conqueror;
+    formula (generator, 6);
+    formula (conqueror, 6);
+    CubeSolver it (conqueror);
+    int res = generator.generate_cubes (3, it);
+    cout << "streamed " << it.cubes << " cubes" << endl;
+    assert (!res);
+    assert (it.cubes > 0);
+    auto cubes = generator.generate_cubes (3);
+    assert (!cubes.status);
+    assert (!cubes.cubes.empty ());
+  }
+
+  {
+    Solver generator, conqueror;
+    formula (generator, 6);
+    formula (conqueror, 6);
+    CubeSolver it (conqueror, 2);
+    int res = generator.generate_cubes (3, it);
+    assert (!res);
+    assert (it.cubes == 2);
+  }
+
+  {
+    // Cubes of the march-style lookahead are refuted and non-tautological.
+    Solver generator, conqueror;
+    generator.set ("march", 1);
+    formula (generator, 6);
+    formula (conqueror, 6);
+    auto cubes = generator.generate_cubes (3);
+    cout << "march generated " << cubes.cubes.size () << " cubes" << endl;
+    assert (!cubes.status);
+    assert (cubes.cubes.size () > 1);
+    CubeSolver it (conqueror);
+    for (const auto & cube : cubes.cubes) {
+      for (size_t i = 0; i < cube.size (); i++)
+        for (size_t j = i + 1; j < cube.size (); j++)
+          assert (abs (cube[i]) != abs (cube[j]));
+      it.cube (cube);
+    }
+  }
+
+  {
+    Solver generator;
+    formula (generator, 6);
+    string icnf = path ("icnf");
+    const char * err = generator.write_cubes (icnf.c_str (), 3);
+    assert (!err);
+    FILE * file = fopen (icnf.c_str (), "r");
+    assert (file);
+    char line[256];
+    assert (fgets (line, sizeof line, file));
+    assert (!strcmp (line, "p inccnf\n"));
+    fclose (file);
+    Solver solver;
+    int vars;
+    bool incremental;
+    vector<int> cube_literals;
+    err = solver.read_dimacs (icnf.c_str (), vars, 0,
+                              incremental, cube_literals);
+    assert (!err);
+    assert (incremental);
+    assert (!cube_literals.empty ());
+    assert (!cube_literals.back ());
+  }
+
+  return 0;
+}
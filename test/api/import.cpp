@@ -0,0 +1,216 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Provides clauses (each given as unit literal or as glue followed by the
+// literals) after 'hasNextClause' has been polled 'at' times.  Since the
+// solver polls before every decision and the assumptions are decided
+// first, the clauses are imported mid-search on decision level 'at'.
+
+class Source : public LearnSource {
+  vector<vector<int>> clauses;
+  size_t next;
+  int polls, at;
+public:
+  Source (const vector<vector<int>> & c, int a) :
+    clauses (c), next (0), polls (0), at (a) { }
+  bool hasNextClause () { return next < clauses.size () && polls++ >= at; }
+  const vector<int> & getNextClause () { return clauses[next++]; }
+  bool imported () const { return next == clauses.size (); }
+};
+
+// Assumes '1', '2', '3' and '4' on decision levels one to four, where '2'
+// also implies '5' on level two, and imports the clause on level four.
+
+static int solve (const vector<int> & clause, Solver & solver) {
+  solver.set ("quiet", 1);
+  solver.set ("lucky", 0);
+  solver.set ("inprocessing", 0);
+  for (int lit : { 5, 6, 7, 8, 0, -2, 5, 0 }) solver.add (lit);
+  for (int lit = 1; lit <= 4; lit++) solver.assume (lit);
+  Source source ({ clause }, 4);
+  solver.connect_learn_source (&source);
+  int res = solver.solve ();
+  solver.disconnect_learn_source ();
+  assert (source.imported ());
+  return res;
+}
+
+// The first six variables are frozen, '10' is equivalent to '1' and '20'
+// only occurs in two clauses.  After 'simplify' the variable '10' is
+// substituted by '1' and '20' is eliminated.  The clauses are imported
+// before the first decision of the following 'solve' call.
+
+static int
+reactivate (const vector<vector<int>> & clauses, Solver & solver) {
+  solver.set ("quiet", 1);
+  solver.set ("lucky", 0);
+  solver.set ("checkwitness", 1);
+  for (int lit : { 1, 2, 3, 0, -1, -2, -3, 0, 4, 5, 6, 0, -4, -5, -6, 0 })
+    solver.add (lit);
+  for (int lit : { -10, 1, 0, 10, -1, 0, 10, 2, 3, 0 }) solver.add (lit);
+  for (int lit : { 20, 1, 2, 0, -20, 3, 4, 0 }) solver.add (lit);
+  for (int idx = 1; idx <= 6; idx++) solver.freeze (idx);
+  int res = solver.simplify ();
+  assert (!res);
+  Source source (clauses, 0);
+  solver.connect_learn_source (&source);
+  res = solver.solve ();
+  solver.disconnect_learn_source ();
+  assert (source.imported ());
+  return res;
+}
+
+// Hands over a single batch of clauses through 'getNextClauses' before the
+// first decision.  Each clause is given as glue followed by its literals
+// and terminated by zero.
+
+class BatchSource : public LearnSource {
+  vector<int> batch, empty;
+  bool handed;
+public:
+  BatchSource (const vector<int> & b) : batch (b), handed (false) { }
+  bool hasNextClause () { return !handed; }
+  const vector<int> & getNextClause () { assert (false); return empty; }
+  bool getNextClauses (const int *& begin, const int *& end) {
+    if (handed) return false;
+    begin = batch.data (), end = begin + batch.size ();
+    handed = true;
+    return true;
+  }
+};
+
+// The batch contains '1 4 -5' three times (once permuted) and '2 -6' twice.
+
+static Solver::Statistics batch (Solver & solver) {
+  solver.set ("quiet", 1);
+  solver.set ("lucky", 0);
+  solver.set ("inprocessing", 0);
+  for (int lit : { 1, 2, 3, 0, -1, -2, -3, 0, 4, 5, 6, 0, -4, -5, -6, 0 })
+    solver.add (lit);
+  BatchSource source ({ 2, 1, 4, -5, 0, 2, -5, 1, 4, 0, 2, 2, -6, 0,
+                        3, 1, 4, -5, 0, 2, -6, 2, 0 });
+  solver.connect_learn_source (&source);
+  int res = solver.solve ();
+  solver.disconnect_learn_source ();
+  assert (res == 10);
+  return solver.get_stats ();
+}
+
+int main () {
+
+  {
+    // Unit clause is assigned on the root level after backtracking.
+    Solver solver;
+    int res = solve ({ -6 }, solver);
+    assert (res == 10);
+    assert (solver.val (6) < 0);
+    assert (solver.fixed (-6) > 0);
+    cout << "imported unit" << endl;
+  }
+
+  {
+    // Falsified clause forces '-3' on level one, before '3' is assumed.
+    Solver solver;
+    int res = solve ({ 2, -1, -3 }, solver);
+    assert (res == 20);
+    assert (solver.failed (3));
+    assert (!solver.failed (4));
+    cout << "imported falsified clause" << endl;
+  }
+
+  {
+    // Both literals are falsified on level two, the level of '2'.
+    Solver solver;
+    int res = solve ({ 2, -2, -5 }, solver);
+    assert (res == 20);
+    assert (solver.failed (2));
+    assert (!solver.failed (3)), assert (!solver.failed (4));
+    cout << "imported conflicting clause" << endl;
+  }
+
+  {
+    // Satisfied by '5' on level two but falsified by '1' on level one,
+    // thus '5' has to be assigned on level one instead.
+    Solver solver;
+    int res = solve ({ 2, 5, -1 }, solver);
+    assert (res == 10);
+    assert (solver.val (5) > 0);
+    cout << "imported late satisfied clause" << endl;
+  }
+
+  {
+    // Units over eliminated and substituted variables are reactivated.
+    Solver solver;
+    solver.set ("sharereactivate", 2);
+    int res = reactivate ({ { -20 }, { -10 } }, solver);
+    assert (res == 10);
+    assert (solver.val (20) < 0);
+    assert (solver.val (10) < 0), assert (solver.val (1) < 0);
+    cout << "imported reactivated units" << endl;
+  }
+
+  {
+    // Same for a binary clause, which becomes a unit after importing '20'.
+    Solver solver;
+    solver.set ("sharereactivate", 2);
+    int res = reactivate ({ { 20 }, { 2, -20, -10 } }, solver);
+    assert (res == 10);
+    assert (solver.val (20) > 0);
+    assert (solver.val (10) < 0), assert (solver.val (1) < 0);
+    cout << "imported reactivated clause" << endl;
+  }
+
+  {
+    // Too many variables to reactivate, thus both units are discarded.
+    Solver solver;
+    solver.set ("sharereactivate", 1);
+    int res = reactivate ({ { -20 }, { -10 } }, solver);
+    assert (res == 10);
+    cout << "discarded units over inactive variables" << endl;
+  }
+
+  {
+    // Substituted literals are mapped to their representative instead.
+    Solver solver;
+    solver.set ("sharerepr", 1);
+    int res = reactivate ({ { -10 } }, solver);
+    assert (res == 10);
+    assert (solver.val (10) < 0), assert (solver.val (1) < 0);
+    cout << "imported unit as representative" << endl;
+  }
+
+  {
+    // Duplicates within a batch are rejected and counted.
+    Solver solver;
+    Solver::Statistics stats = batch (solver);
+    assert (stats.imported == 2);
+    assert (stats.r_dup == 3);
+    assert (stats.discarded == 3);
+    assert (!stats.e_dup);
+    cout << "discarded duplicated clauses in batch" << endl;
+  }
+
+  {
+    // All clauses of the batch are imported (without duplicate filter).
+    Solver solver;
+    solver.set ("sharedup", 0);
+    Solver::Statistics stats = batch (solver);
+    assert (stats.imported == 5);
+    assert (!stats.r_dup && !stats.discarded);
+    assert (solver.val (1) > 0 || solver.val (4) > 0 || solver.val (-5) > 0);
+    assert (solver.val (2) > 0 || solver.val (-6) > 0);
+    cout << "imported batch" << endl;
+  }
+
+  return 0;
+}
@@ -32,6 +32,22 @@ public:
   }
 };
 
+class Batch : CaDiCaL::BatchLearner {
+  CaDiCaL::Solver * solver;
+public:
+  unsigned clauses;
+  Batch (CaDiCaL::Solver * s) : solver (s), clauses (0) {
+    solver->connect_batch_learner (this, 1000, 1000);
+  }
+  ~Batch () { solver->disconnect_batch_learner (); }
+  void learn (const int * begin, const int * end) {
+    for (const int * p = begin + 1; p < end; p++)
+      if (!*p) clauses++, p++;
+    std::cout << "solver[" << ((void*) solver) << "] batch of "
+              << (end - begin) << " integers" << std::endl << std::flush;
+  }
+};
+
 static void formula (CaDiCaL::Solver & solver) {
   for (int r = -1; r < 2; r += 2)
     for (int s = -1; s < 2; s += 2)
@@ -54,5 +70,14 @@ int main () {
   assert (a == b), assert (a == 20);
   assert (wing.clauses == wong.clauses);
   assert (wing.clauses > 3);
+  CaDiCaL::Solver pang;
+  Wrapper wang (&pang);
+  Batch bang (&pang);
+  formula (pang);
+  int c = pang.solve ();
+  std::cout << "pang returns " << c << std::endl;
+  std::cout << "bang imported " << bang.clauses << " clauses" << std::endl;
+  assert (c == 20);
+  assert (bang.clauses + 1 == wang.clauses);    // Without empty clause.
   return 0;
 }
@@ -0,0 +1,49 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Satisfiable formula of ternary clauses over consecutive variables which
+// needs several MB for clauses, watches and variables.
+
+static void formula (Solver & solver) {
+  const int vars = 100000;
+  for (int idx = 1; idx + 2 <= vars; idx++)
+    solver.add (idx), solver.add (-(idx + 1)), solver.add (idx + 2),
+    solver.add (0);
+}
+
+int main () {
+
+  {
+    Solver solver;
+    solver.set ("quiet", 1);
+    solver.set ("memorylimit", 1);
+    formula (solver);
+    int res = solver.solve ();
+    cout << "solve with 'memorylimit=1' returns " << res << endl;
+    assert (!res);
+  }
+
+  {
+    Solver solver;
+    solver.set ("quiet", 1);
+    formula (solver);
+    assert (solver.is_valid_limit ("memory"));
+    assert (solver.limit ("memory", 1));
+    int res = solver.solve ();
+    cout << "solve with memory limit 1 returns " << res << endl;
+    assert (!res);
+    res = solver.solve ();                      // Limit is reset.
+    assert (res == 10);
+  }
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include "../../src/cadical.hpp"
+
+#include <iostream>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+// Pigeon hole formula with 'n' holes (unsatisfiable) or with 'n + 1'
+// holes (satisfiable) for 'n + 1' pigeons.
+
+static int var (int p, int h, int holes) { return 1 + p * holes + h; }
+
+template<class S> static void formula (S & solver, int n, bool sat) {
+  const int pigeons = n + 1, holes = sat ? n + 1 : n;
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < holes; h++)
+      solver.add (var (p, h, holes));
+    solver.add (0);
+  }
+  for (int h = 0; h < holes; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+        solver.add (-var (p, h, holes)),
+        solver.add (-var (q, h, holes)),
+        solver.add (0);
+}
+
+int main () {
+
+  {
+    CaDiCaL::ParallelSolver portfolio (4);
+    formula (portfolio, 7, false);
+    int res = portfolio.solve ();
+    std::cout << "unsatisfiable portfolio returns " << res << std::endl;
+    assert (res == 20);
+    assert (portfolio.winner ());
+  }
+
+  {
+    CaDiCaL::ParallelSolver portfolio (3);
+    const int n = 8;
+    formula (portfolio, n, true);
+    int res = portfolio.solve ();
+    std::cout << "satisfiable portfolio returns " << res << std::endl;
+    assert (res == 10);
+    const int holes = n + 1;
+    for (int p = 0; p <= n; p++) {
+      int placed = 0;
+      for (int h = 0; h < holes; h++)
+        placed += portfolio.val (var (p, h, holes)) > 0;
+      assert (placed > 0);
+    }
+  }
+
+  {
+    CaDiCaL::Solver base;
+    formula (base, 6, false);
+    CaDiCaL::ParallelSolver portfolio (2, &base);
+    int res = portfolio.solve ();
+    std::cout << "copied portfolio returns " << res << std::endl;
+    assert (res == 20);
+  }
+
+  {
+    CaDiCaL::ParallelSolver portfolio (3);
+    portfolio.set ("quiet", 1);
+    portfolio.set ("cubelimit", 100);
+    formula (portfolio, 7, false);
+    int res = portfolio.conquer (3);
+    std::cout << "unsatisfiable cube-and-conquer returns " << res << std::endl;
+    assert (res == 20);
+  }
+
+  {
+    CaDiCaL::ParallelSolver portfolio (2);
+    portfolio.set ("quiet", 1);
+    portfolio.set ("march", 1);
+    formula (portfolio, 7, false);
+    int res = portfolio.conquer (4);
+    std::cout << "march cube-and-conquer returns " << res << std::endl;
+    assert (res == 20);
+  }
+
+  {
+    CaDiCaL::ParallelSolver portfolio (4);
+    const int n = 8;
+    portfolio.set ("quiet", 1);
+    portfolio.set ("cubes", 2);
+    formula (portfolio, n, true);
+    int res = portfolio.solve ();
+    std::cout << "satisfiable cube-and-conquer returns " << res << std::endl;
+    assert (res == 10);
+    const int holes = n + 1;
+    for (int p = 0; p <= n; p++) {
+      int placed = 0;
+      for (int h = 0; h < holes; h++)
+        placed += portfolio.val (var (p, h, holes)) > 0;
+      assert (placed == 1);
+    }
+  }
+
+  return 0;
+}
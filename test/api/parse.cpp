@@ -0,0 +1,92 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "random.hpp"
+
+using namespace std;
+using namespace CaDiCaL;
+
+static string path (const char * suffix) {
+  const char * prefix = getenv ("CADICALBUILD");
+  string res = prefix ? prefix : ".";
+  res += "/test-api-parse.";
+  res += suffix;
+  return res;
+}
+
+// Random formula large enough (several MB) to be parsed in parallel,
+// with comments and clauses spanning lines.  If 'broken' is non-zero a
+// literal exceeding the maximum variable is added after that many clauses.
+
+static void generate (const string & name, int broken) {
+  const int vars = 5000, clauses = 300000;
+  FILE * file = fopen (name.c_str (), "w");
+  assert (file);
+  fprintf (file, "c random test formula\np cnf %d %d\n", vars, clauses);
+  RandomLiterals random (vars);
+  for (int i = 0; i < clauses; i++) {
+    if (i == broken) fprintf (file, "%d ", vars + 1);
+    for (int j = 0; j < 3; j++) {
+      const int lit = random.lit ();
+      fprintf (file, "%d%s", lit, (random.bits () & 7) ? " " : "\n");
+    }
+    fputs ((i % 1000) ? "0\n" : "0 c comment\n", file);
+  }
+  fclose (file);
+}
+
+static const char *
+parse (const string & name, int threads, const string & output) {
+  Solver solver;
+  solver.set ("quiet", 1);
+  solver.set ("parsethreads", threads);
+  int vars;
+  const char * err = solver.read_dimacs (name.c_str (), vars);
+  static string msg;
+  if (err) return (msg = err).c_str ();
+  assert (vars == 5000);
+  err = solver.write_dimacs (output.c_str ());
+  assert (!err);
+  return 0;
+}
+
+static bool same (const string & a, const string & b) {
+  FILE * f = fopen (a.c_str (), "r"), * g = fopen (b.c_str (), "r");
+  assert (f), assert (g);
+  int ch, res = 1;
+  while (res && (ch = getc (f)) != EOF) res = (ch == getc (g));
+  if (res) res = (getc (g) == EOF);
+  fclose (f), fclose (g);
+  return res;
+}
+
+int main () {
+
+  const string cnf = path ("cnf");
+  const string sequential = path ("sequential"), parallel = path ("parallel");
+
+  generate (cnf, -1);
+  assert (!parse (cnf, 1, sequential));
+  assert (!parse (cnf, 4, parallel));
+  assert (same (sequential, parallel));
+  cout << "parsed formula in parallel" << endl;
+
+  generate (cnf, 200000);
+  string expected = parse (cnf, 1, sequential);
+  const char * err = parse (cnf, 4, parallel);
+  assert (err);
+  cout << err << endl;
+  assert (expected == err);
+
+  return 0;
+}
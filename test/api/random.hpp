@@ -0,0 +1,22 @@
+#ifndef _random_hpp_INCLUDED
+#define _random_hpp_INCLUDED
+
+// Random literals for generating test formulas, with a fixed seed by
+// default, so the formulas are the same for every run.  This is a simple
+// linear congruential generator and the literal is taken from its higher
+// bits, since the lower bits have short periods.
+
+class RandomLiterals {
+  unsigned state;
+  int vars;
+public:
+  RandomLiterals (int v, unsigned seed = 42) : state (seed), vars (v) { }
+  int lit () {
+    state = state * 1664525u + 1013904223u;
+    int res = 1 + (state >> 8) % vars;
+    return (state & 0x80000000u) ? -res : res;
+  }
+  unsigned bits () const { return state; }    // of the last literal
+};
+
+#endif
@@ -107,8 +107,14 @@ run ctest
 run example
 run terminate
 run learn
+run import
 run cfreeze
+run parallel
 run traverse
+run cubes
+run parse
+run memory
+run clone
 run cipasir
 
 [ "`grep DNTRACING $makefile`" = "" ] && run apitrace